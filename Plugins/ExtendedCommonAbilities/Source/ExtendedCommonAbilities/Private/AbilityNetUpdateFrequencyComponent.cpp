@@ -0,0 +1,177 @@
+﻿// Copyright Bohdon Sayre, All Rights Reserved.
+
+
+#include "AbilityNetUpdateFrequencyComponent.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "ExtendedAbilitySystemComponent.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+
+
+UAbilityNetUpdateFrequencyComponent::UAbilityNetUpdateFrequencyComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer),
+	  ActiveNetUpdateFrequency(100.f),
+	  IdleNetUpdateFrequency(10.f),
+	  IdleDelay(2.f),
+	  bForceNetUpdateWhenActivated(true),
+	  LastActivityTime(0.0),
+	  bIsActive(false)
+{
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UAbilityNetUpdateFrequencyComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AActor* Owner = GetOwner();
+	if (Owner && Owner->HasAuthority())
+	{
+		SetAbilitySystem(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Owner));
+
+		// start active, since initial abilities and effects are usually granted right after spawning
+		NotifyActivity();
+	}
+}
+
+void UAbilityNetUpdateFrequencyComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	SetAbilitySystem(nullptr);
+
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(IdleTimerHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UAbilityNetUpdateFrequencyComponent::SetAbilitySystem(UAbilitySystemComponent* InAbilitySystem)
+{
+	if (AbilitySystem == InAbilitySystem)
+	{
+		return;
+	}
+
+	if (AbilitySystem)
+	{
+		AbilitySystem->OnGameplayEffectAppliedDelegateToSelf.RemoveAll(this);
+		AbilitySystem->OnAnyGameplayEffectRemovedDelegate().RemoveAll(this);
+		AbilitySystem->AbilityActivatedCallbacks.RemoveAll(this);
+		AbilitySystem->OnAbilityEnded.RemoveAll(this);
+		AbilitySystem->AbilitySpecDirtiedCallbacks.RemoveAll(this);
+		if (UExtendedAbilitySystemComponent* ExtendedAbilitySystem = Cast<UExtendedAbilitySystemComponent>(AbilitySystem))
+		{
+			ExtendedAbilitySystem->OnAttributeReplicationDirtiedEvent.RemoveAll(this);
+		}
+	}
+
+	AbilitySystem = InAbilitySystem;
+
+	if (AbilitySystem)
+	{
+		// applied rather than added, so that instant effects such as damage are included
+		AbilitySystem->OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &ThisClass::OnEffectApplied);
+		AbilitySystem->OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &ThisClass::OnAnyEffectRemoved);
+		AbilitySystem->AbilityActivatedCallbacks.AddUObject(this, &ThisClass::OnAbilityActivated);
+		AbilitySystem->OnAbilityEnded.AddUObject(this, &ThisClass::OnAbilityEnded);
+		AbilitySystem->AbilitySpecDirtiedCallbacks.AddUObject(this, &ThisClass::OnAbilitySpecDirtied);
+
+		// attribute sets report when they dirty replicated data, which also covers sets that are added later
+		if (UExtendedAbilitySystemComponent* ExtendedAbilitySystem = Cast<UExtendedAbilitySystemComponent>(AbilitySystem))
+		{
+			ExtendedAbilitySystem->OnAttributeReplicationDirtiedEvent.AddUObject(this, &ThisClass::OnAttributeReplicationDirtied);
+		}
+	}
+}
+
+void UAbilityNetUpdateFrequencyComponent::NotifyActivity()
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	LastActivityTime = World->GetTimeSeconds();
+
+	if (!bIsActive)
+	{
+		bIsActive = true;
+		SetNetUpdateFrequency(ActiveNetUpdateFrequency);
+
+		if (bForceNetUpdateWhenActivated)
+		{
+			GetOwner()->ForceNetUpdate();
+		}
+	}
+
+	if (!IdleTimerHandle.IsValid())
+	{
+		World->GetTimerManager().SetTimer(IdleTimerHandle, this, &ThisClass::OnIdleTimer, FMath::Max(IdleDelay, UE_KINDA_SMALL_NUMBER), false);
+	}
+}
+
+void UAbilityNetUpdateFrequencyComponent::OnIdleTimer()
+{
+	IdleTimerHandle.Invalidate();
+
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	// activity only records a time, so check again later instead of resetting the timer on every change
+	const double IdleTime = World->GetTimeSeconds() - LastActivityTime;
+	if (IdleTime < IdleDelay)
+	{
+		World->GetTimerManager().SetTimer(IdleTimerHandle, this, &ThisClass::OnIdleTimer, IdleDelay - IdleTime, false);
+		return;
+	}
+
+	bIsActive = false;
+	SetNetUpdateFrequency(IdleNetUpdateFrequency);
+}
+
+void UAbilityNetUpdateFrequencyComponent::SetNetUpdateFrequency(float NewFrequency)
+{
+	if (AActor* Owner = GetOwner())
+	{
+		Owner->SetNetUpdateFrequency(NewFrequency);
+	}
+}
+
+void UAbilityNetUpdateFrequencyComponent::OnEffectApplied(UAbilitySystemComponent* Target,
+                                                          const FGameplayEffectSpec& SpecApplied,
+                                                          FActiveGameplayEffectHandle ActiveHandle)
+{
+	NotifyActivity();
+}
+
+void UAbilityNetUpdateFrequencyComponent::OnAnyEffectRemoved(const FActiveGameplayEffect& Effect)
+{
+	NotifyActivity();
+}
+
+void UAbilityNetUpdateFrequencyComponent::OnAttributeReplicationDirtied()
+{
+	NotifyActivity();
+}
+
+void UAbilityNetUpdateFrequencyComponent::OnAbilityActivated(UGameplayAbility* Ability)
+{
+	NotifyActivity();
+}
+
+void UAbilityNetUpdateFrequencyComponent::OnAbilityEnded(const FAbilityEndedData& EndedData)
+{
+	NotifyActivity();
+}
+
+void UAbilityNetUpdateFrequencyComponent::OnAbilitySpecDirtied(const FGameplayAbilitySpec& AbilitySpec)
+{
+	NotifyActivity();
+}
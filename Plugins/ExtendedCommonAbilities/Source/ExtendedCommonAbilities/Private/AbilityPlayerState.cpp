@@ -3,8 +3,10 @@
 
 #include "AbilityPlayerState.h"
 
+#include "AbilityNetUpdateFrequencyComponent.h"
 #include "ExtendedAbilitySystemComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "Teams/CommonTeamsComponent.h"
 #include "Teams/CommonTeamStatics.h"
 
 
@@ -16,8 +18,9 @@ AAbilityPlayerState::AAbilityPlayerState(const FObjectInitializer& ObjectInitial
 	AbilitySystem->SetIsReplicated(true);
 	AbilitySystem->SetReplicationMode(EGameplayEffectReplicationMode::Mixed);
 
-	// replicate ability system at a high frequency
+	// replicate ability system at a high frequency, lowered while idle
 	SetNetUpdateFrequency(100.f);
+	NetUpdateFrequencyComponent = CreateDefaultSubobject<UAbilityNetUpdateFrequencyComponent>(TEXT("NetUpdateFrequency"));
 }
 
 UAbilitySystemComponent* AAbilityPlayerState::GetAbilitySystemComponent() const
@@ -51,6 +54,16 @@ int32 AAbilityPlayerState::GetTeamId() const
 	return UCommonTeamStatics::GenericTeamIdToInteger(TeamId);
 }
 
+void AAbilityPlayerState::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCommonTeamsComponent* TeamsComponent = UCommonTeamStatics::GetTeamsComponent(this))
+	{
+		TeamsComponent->RemovePlayer(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AAbilityPlayerState::OnRep_TeamId(FGenericTeamId OldTeamId)
 {
 	BroadcastTeamChanged(TeamId, OldTeamId);
@@ -60,6 +73,12 @@ void AAbilityPlayerState::BroadcastTeamChanged(const FGenericTeamId& NewTeamId,
 {
 	const int32 OldIdInt = UCommonTeamStatics::GenericTeamIdToInteger(OldTeamId);
 	const int32 NewIdInt = UCommonTeamStatics::GenericTeamIdToInteger(NewTeamId);
+
+	if (UCommonTeamsComponent* TeamsComponent = UCommonTeamStatics::GetTeamsComponent(this))
+	{
+		TeamsComponent->UpdatePlayerTeam(this);
+	}
+
 	OnTeamChangedEvent.Broadcast(this, NewIdInt, OldIdInt);
 	OnTeamChangedEvent_BP.Broadcast(this, NewIdInt, OldIdInt);
 }
@@ -0,0 +1,12 @@
+﻿// Copyright Bohdon Sayre, All Rights Reserved.
+
+
+#include "CommonAbilitySystemGlobals.h"
+
+#include "CommonGameplayEffectContext.h"
+
+
+FGameplayEffectContext* UCommonAbilitySystemGlobals::AllocGameplayEffectContext() const
+{
+	return new FCommonGameplayEffectContext();
+}
@@ -0,0 +1,61 @@
+﻿// Copyright Bohdon Sayre, All Rights Reserved.
+
+
+#include "CommonGameplayEffectContext.h"
+
+#include "Teams/CommonTeamsComponent.h"
+#include "Teams/CommonTeamStatics.h"
+
+
+FCommonGameplayEffectContext* FCommonGameplayEffectContext::Get(const FGameplayEffectContextHandle& Handle)
+{
+	FGameplayEffectContext* Context = Handle.Get();
+	if (Context && Context->GetScriptStruct()->IsChildOf(StaticStruct()))
+	{
+		return static_cast<FCommonGameplayEffectContext*>(Context);
+	}
+	return nullptr;
+}
+
+void FCommonGameplayEffectContext::AddInstigator(AActor* InInstigator, AActor* InEffectCauser)
+{
+	Super::AddInstigator(InInstigator, InEffectCauser);
+
+	InstigatorTeamId = FGenericTeamId::NoTeam;
+	bHasInstigatorTeamId = false;
+
+	if (const UCommonTeamsComponent* TeamsComp = InInstigator ? UCommonTeamStatics::GetTeamsComponent(InInstigator) : nullptr)
+	{
+		InstigatorTeamId = TeamsComp->GetObjectGenericTeamId(InInstigator);
+		bHasInstigatorTeamId = true;
+	}
+}
+
+FCommonGameplayEffectContext* FCommonGameplayEffectContext::Duplicate() const
+{
+	FCommonGameplayEffectContext* NewContext = new FCommonGameplayEffectContext();
+	*NewContext = *this;
+	if (GetHitResult())
+	{
+		// deep copy the hit result
+		NewContext->AddHitResult(*GetHitResult(), true);
+	}
+	return NewContext;
+}
+
+bool FCommonGameplayEffectContext::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Super::NetSerialize(Ar, Map, bOutSuccess);
+
+	uint8 bHasTeamId = bHasInstigatorTeamId ? 1 : 0;
+	Ar.SerializeBits(&bHasTeamId, 1);
+	bHasInstigatorTeamId = bHasTeamId != 0;
+	if (bHasInstigatorTeamId)
+	{
+		uint8 TeamId = InstigatorTeamId.GetId();
+		Ar << TeamId;
+		InstigatorTeamId = FGenericTeamId(TeamId);
+	}
+
+	return true;
+}
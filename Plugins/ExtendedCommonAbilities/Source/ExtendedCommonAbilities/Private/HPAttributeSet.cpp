@@ -70,6 +70,6 @@ void UHPAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutL
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION_NOTIFY(UHPAttributeSet, HP, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UHPAttributeSet, MaxHP, COND_None, REPNOTIFY_Always);
+	EXTENDED_ATTRIBUTE_REPLIFETIME(UHPAttributeSet, HP);
+	EXTENDED_ATTRIBUTE_REPLIFETIME(UHPAttributeSet, MaxHP);
 }
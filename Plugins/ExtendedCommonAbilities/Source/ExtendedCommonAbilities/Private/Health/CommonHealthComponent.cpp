@@ -34,7 +34,10 @@ void UCommonHealthComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UCommonHealthComponent, HealthState);
+	FDoRepLifetimeParams SharedParams;
+	SharedParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, HealthState, SharedParams);
 }
 
 void UCommonHealthComponent::InitializeComponent()
@@ -134,6 +137,7 @@ void UCommonHealthComponent::StartDeath()
 	if (HealthState == ECommonHealthState::Alive)
 	{
 		HealthState = ECommonHealthState::DeathStarted;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, HealthState, this);
 		OnDeathStarted();
 	}
 }
@@ -143,6 +147,7 @@ void UCommonHealthComponent::FinishDeath()
 	if (HealthState == ECommonHealthState::DeathStarted)
 	{
 		HealthState = ECommonHealthState::DeathFinished;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, HealthState, this);
 		OnDeathFinished();
 	}
 }
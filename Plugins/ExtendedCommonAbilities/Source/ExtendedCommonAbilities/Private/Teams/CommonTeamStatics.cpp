@@ -3,21 +3,13 @@
 
 #include "Teams/CommonTeamStatics.h"
 
-#include "Engine/Engine.h"
-#include "GameFramework/GameStateBase.h"
+#include "GameStateComponentSubsystem.h"
 #include "Teams/CommonTeamsComponent.h"
 
 
 UCommonTeamsComponent* UCommonTeamStatics::GetTeamsComponent(const UObject* WorldContextObject)
 {
-	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
-	{
-		if (const AGameStateBase* GameState = World->GetGameState())
-		{
-			return GameState->FindComponentByClass<UCommonTeamsComponent>();
-		}
-	}
-	return nullptr;
+	return UGameStateComponentSubsystem::FindComponent<UCommonTeamsComponent>(WorldContextObject);
 }
 
 void UCommonTeamStatics::CompareTeams(const UObject* ObjectA, const UObject* ObjectB, TEnumAsByte<ETeamAttitude::Type>& Attitude, ECommonTeamComparison& Comparison)
@@ -33,3 +25,16 @@ void UCommonTeamStatics::CompareTeams(const UObject* ObjectA, const UObject* Obj
 		Comparison = ECommonTeamComparison::NoTeam;
 	}
 }
+
+TArray<AActor*> UCommonTeamStatics::FilterActorsByTeam(const UObject* Instigator, const TArray<AActor*>& Actors, int32 AttitudeMask, int32 ComparisonMask)
+{
+	const UCommonTeamsComponent* TeamsComp = GetTeamsComponent(Instigator);
+	if (!TeamsComp)
+	{
+		return Actors;
+	}
+
+	TArray<AActor*> Result;
+	TeamsComp->FilterActorsByTeam(Instigator, Actors, static_cast<uint8>(AttitudeMask), static_cast<uint8>(ComparisonMask), Result);
+	return Result;
+}
@@ -3,12 +3,55 @@
 
 #include "Teams/CommonTeamsComponent.h"
 
+#include "GameStateComponentSubsystem.h"
 #include "GenericTeamAgentInterface.h"
 #include "Framework/Commands/GenericCommands.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
 #include "GameFramework/PlayerState.h"
 #include "Teams/CommonTeamStatics.h"
 
 
+namespace CommonTeamsComponent
+{
+	constexpr uint8 UnknownAttitude = MAX_uint8;
+}
+
+
+// FCommonTeamFilter
+// -----------------
+
+FCommonTeamFilter::FCommonTeamFilter(const UCommonTeamsComponent& InTeamsComponent, FGenericTeamId InInstigatorTeamId,
+                                     uint8 InAttitudeMask, uint8 InComparisonMask)
+	: TeamsComponent(InTeamsComponent),
+	  InstigatorTeamId(InInstigatorTeamId),
+	  AttitudeMask(InAttitudeMask),
+	  ComparisonMask(InComparisonMask)
+{
+	FMemory::Memzero(ResultsByTeam);
+}
+
+bool FCommonTeamFilter::PassesTeam(FGenericTeamId TeamId)
+{
+	uint8& Result = ResultsByTeam[TeamId.GetId()];
+	if (Result == 0)
+	{
+		const bool bPasses = FCommonTeamTypes::MatchesAttitudeMask(TeamsComponent.GetTeamAttitude(InstigatorTeamId, TeamId), AttitudeMask) &&
+			FCommonTeamTypes::MatchesComparisonMask(UCommonTeamsComponent::CompareTeamIds(InstigatorTeamId, TeamId), ComparisonMask);
+		Result = bPasses ? 2 : 1;
+	}
+	return Result == 2;
+}
+
+bool FCommonTeamFilter::PassesObject(const UObject* Object)
+{
+	return PassesTeam(TeamsComponent.GetObjectGenericTeamId(Object));
+}
+
+
+// UCommonTeamsComponent
+// ---------------------
+
 UCommonTeamsComponent::UCommonTeamsComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -23,6 +66,17 @@ void UCommonTeamsComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if (UGameStateComponentSubsystem* ComponentSubsystem = UGameStateComponentSubsystem::Get(this))
+	{
+		ComponentSubsystem->RegisterComponent(this);
+	}
+
+	// add players that were assigned teams before this began play
+	for (const TObjectPtr<APlayerState>& PlayerState : GetGameStateChecked<AGameStateBase>()->PlayerArray)
+	{
+		UpdatePlayerTeam(PlayerState);
+	}
+
 	StartTeamSetup();
 }
 
@@ -30,7 +84,18 @@ void UCommonTeamsComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	if (UGameStateComponentSubsystem* ComponentSubsystem = UGameStateComponentSubsystem::Get(this))
+	{
+		ComponentSubsystem->UnregisterComponent(this);
+	}
+
 	FGameModeEvents::GameModePostLoginEvent.RemoveAll(this);
+	FGameModeEvents::GameModeLogoutEvent.RemoveAll(this);
+
+	TeamRosters.Reset();
+	PlayerTeams.Reset();
+	ClearTeamAgentCache();
+	ClearAttitudeCache();
 }
 
 void UCommonTeamsComponent::StartTeamSetup()
@@ -62,47 +127,119 @@ int32 UCommonTeamsComponent::GetLeastPopulatedTeam() const
 		return INDEX_NONE;
 	}
 
-	TMap<int32, uint32> TeamMemberCounts;
-	TeamMemberCounts.Reserve(TeamDefinitions.Num());
-
+	// return the lowest count, or the lowest-number team ID if counts match
+	int32 BestId = INDEX_NONE;
+	int32 LowestCount = MAX_int32;
 	for (const auto& Elem : TeamDefinitions)
 	{
-		TeamMemberCounts.Add(Elem.Key, 0);
-	}
-
-	AGameStateBase* GameState = GetGameStateChecked<AGameStateBase>();
-	for (const TObjectPtr<APlayerState>& PlayerState : GameState->PlayerArray)
-	{
-		if (PlayerState->IsInactive())
+		const int32 TeamId = Elem.Key;
+		const int32 MemberCount = GetTeamMemberCount(TeamId);
+		if (MemberCount < LowestCount || (MemberCount == LowestCount && TeamId < BestId))
 		{
-			continue;
+			BestId = TeamId;
+			LowestCount = MemberCount;
 		}
+	}
+	return BestId;
+}
 
-		// find members
-		if (const IGenericTeamAgentInterface* TeamInterface = Cast<IGenericTeamAgentInterface>(PlayerState))
+TArray<APlayerState*> UCommonTeamsComponent::GetTeamMembers(int32 TeamId) const
+{
+	TArray<APlayerState*> Result;
+	if (const FCommonTeamRoster* Roster = TeamRosters.Find(TeamId))
+	{
+		Result.Reserve(Roster->Members.Num());
+		for (APlayerState* Member : Roster->Members)
 		{
-			const uint8 TeamId = TeamInterface->GetGenericTeamId().GetId();
-			if (TeamMemberCounts.Contains(TeamId))
+			if (IsValid(Member))
 			{
-				TeamMemberCounts[TeamId]++;
+				Result.Add(Member);
 			}
 		}
 	}
+	return Result;
+}
 
-	// return the lowest count, or the lowest-number team ID if counts match
-	int32 BestId = INDEX_NONE;
-	uint32 LowestCount = TNumericLimits<uint32>::Max();
-	for (const TPair<int32, uint32>& Elem : TeamMemberCounts)
+int32 UCommonTeamsComponent::GetTeamMemberCount(int32 TeamId) const
+{
+	const FCommonTeamRoster* Roster = TeamRosters.Find(TeamId);
+	if (!Roster)
 	{
-		const int32 TeamId = Elem.Key;
-		const uint32 MemberCount = Elem.Value;
-		if (MemberCount < LowestCount || BestId == INDEX_NONE || TeamId < BestId)
+		return 0;
+	}
+
+	int32 Count = 0;
+	for (const APlayerState* Member : Roster->Members)
+	{
+		Count += IsValid(Member) ? 1 : 0;
+	}
+	return Count;
+}
+
+void UCommonTeamsComponent::UpdatePlayerTeam(APlayerState* PlayerState)
+{
+	if (!PlayerState)
+	{
+		return;
+	}
+
+	const IGenericTeamAgentInterface* TeamInterface = Cast<IGenericTeamAgentInterface>(PlayerState);
+	if (!TeamInterface || PlayerState->IsInactive())
+	{
+		RemovePlayer(PlayerState);
+		return;
+	}
+
+	const int32 NewTeamId = UCommonTeamStatics::GenericTeamIdToInteger(TeamInterface->GetGenericTeamId());
+	const int32* OldTeamId = PlayerTeams.Find(PlayerState);
+	if (OldTeamId && *OldTeamId == NewTeamId)
+	{
+		return;
+	}
+
+	RemovePlayer(PlayerState);
+	PruneTeamRosters();
+
+	if (NewTeamId != INDEX_NONE)
+	{
+		TeamRosters.FindOrAdd(NewTeamId).Members.Add(PlayerState);
+		PlayerTeams.Add(PlayerState, NewTeamId);
+		OnTeamRosterChangedEvent.Broadcast(NewTeamId);
+	}
+}
+
+void UCommonTeamsComponent::RemovePlayer(APlayerState* PlayerState)
+{
+	int32 OldTeamId;
+	if (!PlayerTeams.RemoveAndCopyValue(PlayerState, OldTeamId))
+	{
+		return;
+	}
+
+	if (FCommonTeamRoster* Roster = TeamRosters.Find(OldTeamId))
+	{
+		Roster->Members.RemoveSingleSwap(PlayerState, EAllowShrinking::No);
+	}
+	OnTeamRosterChangedEvent.Broadcast(OldTeamId);
+}
+
+void UCommonTeamsComponent::PruneTeamRosters()
+{
+	for (auto& Elem : TeamRosters)
+	{
+		Elem.Value.Members.RemoveAllSwap([](const TObjectPtr<APlayerState>& Member)
 		{
-			BestId = TeamId;
-			LowestCount = MemberCount;
+			return !IsValid(Member);
+		}, EAllowShrinking::No);
+	}
+
+	for (auto It = PlayerTeams.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
 		}
 	}
-	return BestId;
 }
 
 IGenericTeamAgentInterface* UCommonTeamsComponent::GetTeamInterfaceForObject(UObject* Object) const
@@ -140,9 +277,101 @@ const IGenericTeamAgentInterface* UCommonTeamsComponent::GetTeamInterfaceForObje
 	return GetTeamInterfaceForObject(const_cast<UObject*>(Object));
 }
 
+const IGenericTeamAgentInterface* UCommonTeamsComponent::FindTeamInterfaceForObject(const UObject* Object) const
+{
+	if (!Object)
+	{
+		return nullptr;
+	}
+
+	if (const FCommonCachedTeamAgent* CachedAgent = TeamAgentCache.Find(Object))
+	{
+		bool bIsValid = true;
+		switch (CachedAgent->Source)
+		{
+		case FCommonCachedTeamAgent::ESource::Pawn:
+			bIsValid = static_cast<const APawn*>(Object)->GetPlayerState() == CachedAgent->PlayerState;
+			break;
+		case FCommonCachedTeamAgent::ESource::Controller:
+			bIsValid = static_cast<const AController*>(Object)->PlayerState == CachedAgent->PlayerState;
+			break;
+		default:
+			break;
+		}
+
+		if (bIsValid && (!CachedAgent->Agent || CachedAgent->AgentObject.IsValid()))
+		{
+			return CachedAgent->Agent;
+		}
+	}
+
+	IGenericTeamAgentInterface* TeamInterface = GetTeamInterfaceForObject(Object);
+
+	if (TeamAgentCache.Num() >= TeamAgentCachePruneSize)
+	{
+		// remove entries for destroyed objects
+		for (auto It = TeamAgentCache.CreateIterator(); It; ++It)
+		{
+			if (!It->Key.ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		TeamAgentCachePruneSize = FMath::Max(256, TeamAgentCache.Num() * 2);
+	}
+
+	FCommonCachedTeamAgent& NewCachedAgent = TeamAgentCache.FindOrAdd(Object);
+	NewCachedAgent.Agent = TeamInterface;
+	NewCachedAgent.AgentObject = Cast<UObject>(TeamInterface);
+	NewCachedAgent.PlayerState = nullptr;
+	NewCachedAgent.Source = FCommonCachedTeamAgent::ESource::Object;
+	if (const APawn* Pawn = Cast<APawn>(Object))
+	{
+		NewCachedAgent.Source = FCommonCachedTeamAgent::ESource::Pawn;
+		NewCachedAgent.PlayerState = Pawn->GetPlayerState();
+	}
+	else if (const AController* Controller = Cast<AController>(Object))
+	{
+		NewCachedAgent.Source = FCommonCachedTeamAgent::ESource::Controller;
+		NewCachedAgent.PlayerState = Controller->PlayerState;
+	}
+
+	return TeamInterface;
+}
+
+void UCommonTeamsComponent::ClearTeamAgentCache()
+{
+	TeamAgentCache.Reset();
+}
+
+void UCommonTeamsComponent::ClearAttitudeCache()
+{
+	AttitudeCache.Reset();
+}
+
+ETeamAttitude::Type UCommonTeamsComponent::GetTeamAttitude(FGenericTeamId TeamIdA, FGenericTeamId TeamIdB) const
+{
+	if (TeamIdA == FGenericTeamId::NoTeam || TeamIdB == FGenericTeamId::NoTeam)
+	{
+		return ETeamAttitude::Neutral;
+	}
+
+	if (AttitudeCache.IsEmpty())
+	{
+		AttitudeCache.Init(CommonTeamsComponent::UnknownAttitude, 256 * 256);
+	}
+
+	uint8& Attitude = AttitudeCache[TeamIdA.GetId() * 256 + TeamIdB.GetId()];
+	if (Attitude == CommonTeamsComponent::UnknownAttitude)
+	{
+		Attitude = FGenericTeamId::GetAttitude(TeamIdA, TeamIdB);
+	}
+	return static_cast<ETeamAttitude::Type>(Attitude);
+}
+
 FGenericTeamId UCommonTeamsComponent::GetObjectGenericTeamId(const UObject* Object) const
 {
-	if (const IGenericTeamAgentInterface* TeamInterface = GetTeamInterfaceForObject(Object))
+	if (const IGenericTeamAgentInterface* TeamInterface = FindTeamInterfaceForObject(Object))
 	{
 		return TeamInterface->GetGenericTeamId();
 	}
@@ -164,21 +393,17 @@ void UCommonTeamsComponent::SetObjectTeam(UObject* Object, int32 NewTeamId)
 
 TEnumAsByte<ETeamAttitude::Type> UCommonTeamsComponent::GetAttitude(const UObject* ObjectA, const UObject* ObjectB) const
 {
-	const FGenericTeamId TeamIdA = GetObjectGenericTeamId(ObjectA);
-	const FGenericTeamId TeamIdB = GetObjectGenericTeamId(ObjectB);
-	if (TeamIdA == FGenericTeamId::NoTeam || TeamIdB == FGenericTeamId::NoTeam)
-	{
-		return ETeamAttitude::Neutral;
-	}
-	return FGenericTeamId::GetAttitude(TeamIdA, TeamIdB);
+	return GetTeamAttitude(GetObjectGenericTeamId(ObjectA), GetObjectGenericTeamId(ObjectB));
 }
 
 ECommonTeamComparison UCommonTeamsComponent::CompareTeams(const UObject* ObjectA, const UObject* ObjectB) const
 {
-	const int32 TeamIdA = GetObjectTeam(ObjectA);
-	const int32 TeamIdB = GetObjectTeam(ObjectB);
+	return CompareTeamIds(GetObjectGenericTeamId(ObjectA), GetObjectGenericTeamId(ObjectB));
+}
 
-	if (TeamIdA == INDEX_NONE || TeamIdB == INDEX_NONE)
+ECommonTeamComparison UCommonTeamsComponent::CompareTeamIds(FGenericTeamId TeamIdA, FGenericTeamId TeamIdB)
+{
+	if (TeamIdA == FGenericTeamId::NoTeam || TeamIdB == FGenericTeamId::NoTeam)
 	{
 		return ECommonTeamComparison::NoTeam;
 	}
@@ -186,6 +411,27 @@ ECommonTeamComparison UCommonTeamsComponent::CompareTeams(const UObject* ObjectA
 	return TeamIdA == TeamIdB ? ECommonTeamComparison::SameTeam : ECommonTeamComparison::DifferentTeams;
 }
 
+void UCommonTeamsComponent::FilterActorsByTeam(const UObject* Instigator, TConstArrayView<AActor*> Actors, uint8 AttitudeMask, uint8 ComparisonMask,
+                                               TArray<AActor*>& OutActors) const
+{
+	OutActors.Reserve(OutActors.Num() + Actors.Num());
+
+	if (AttitudeMask == FCommonTeamTypes::AllAttitudesMask && ComparisonMask == FCommonTeamTypes::AllComparisonsMask)
+	{
+		OutActors.Append(Actors.GetData(), Actors.Num());
+		return;
+	}
+
+	FCommonTeamFilter Filter(*this, GetObjectGenericTeamId(Instigator), AttitudeMask, ComparisonMask);
+	for (AActor* Actor : Actors)
+	{
+		if (Actor && Filter.PassesObject(Actor))
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
 #if WITH_SERVER_CODE
 void UCommonTeamsComponent::ServerAssignTeamsForPlayers()
 {
@@ -196,6 +442,7 @@ void UCommonTeamsComponent::ServerAssignTeamsForPlayers()
 	}
 
 	FGameModeEvents::GameModePostLoginEvent.AddUObject(this, &UCommonTeamsComponent::OnPlayerPostLogin);
+	FGameModeEvents::GameModeLogoutEvent.AddUObject(this, &UCommonTeamsComponent::OnPlayerLogout);
 }
 
 void UCommonTeamsComponent::ServerAssignTeamForPlayer(APlayerState* PlayerState)
@@ -204,6 +451,9 @@ void UCommonTeamsComponent::ServerAssignTeamForPlayer(APlayerState* PlayerState)
 	{
 		const FGenericTeamId TeamId = UCommonTeamStatics::IntegerToGenericTeamId(SelectTeamForPlayer(PlayerState));
 		TeamInterface->SetGenericTeamId(TeamId);
+
+		// player states that don't notify team changes are updated here
+		UpdatePlayerTeam(PlayerState);
 	}
 }
 
@@ -214,4 +464,12 @@ void UCommonTeamsComponent::OnPlayerPostLogin(AGameModeBase* GameMode, APlayerCo
 		ServerAssignTeamForPlayer(NewPlayer->PlayerState);
 	}
 }
+
+void UCommonTeamsComponent::OnPlayerLogout(AGameModeBase* GameMode, AController* Exiting)
+{
+	if (Exiting && Exiting->PlayerState)
+	{
+		RemovePlayer(Exiting->PlayerState);
+	}
+}
 #endif
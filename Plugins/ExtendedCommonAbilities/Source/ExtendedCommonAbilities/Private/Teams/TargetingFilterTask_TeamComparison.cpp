@@ -23,7 +23,28 @@ void UTargetingFilterTask_TeamComparison::Execute(const FTargetingRequestHandle&
 
 	if (TargetingHandle.IsValid())
 	{
-		if (FTargetingDefaultResultsSet* ResultData = FTargetingDefaultResultsSet::Find(TargetingHandle))
+		FTargetingDefaultResultsSet* ResultData = FTargetingDefaultResultsSet::Find(TargetingHandle);
+		const FTargetingSourceContext* SourceContext = FTargetingSourceContext::Find(TargetingHandle);
+		const AActor* Instigator = SourceContext ? SourceContext->InstigatorActor.Get() : nullptr;
+		const UCommonTeamsComponent* TeamsComp = Instigator ? UCommonTeamStatics::GetTeamsComponent(Instigator) : nullptr;
+
+		if (ResultData && TeamsComp)
+		{
+			// resolve the instigator's team once, and cache results per target team
+			FCommonTeamFilter Filter(*TeamsComp, TeamsComp->GetObjectGenericTeamId(Instigator), AttitudeMask, ComparisonMask);
+
+			ResultData->TargetResults.RemoveAll([this, &Filter](const FTargetingDefaultResultData& TargetResult)
+			{
+				const AActor* HitActor = TargetResult.HitResult.GetActor();
+				if (!HitActor)
+				{
+					// require an actor to pass this filter
+					return !bIncludeNonBlockingHit;
+				}
+				return !Filter.PassesObject(HitActor);
+			});
+		}
+		else if (ResultData)
 		{
 			const int32 NumTargets = ResultData->TargetResults.Num();
 			for (int32 TargetIterator = NumTargets - 1; TargetIterator >= 0; --TargetIterator)
@@ -4,6 +4,7 @@
 #include "Teams/TeamComparisonGameplayEffectComponent.h"
 
 #include "AbilitySystemComponent.h"
+#include "CommonGameplayEffectContext.h"
 #include "Teams/CommonTeamsComponent.h"
 #include "Teams/CommonTeamStatics.h"
 #include "UI/VM_ActiveGameplayEffects.h"
@@ -29,16 +30,35 @@ bool UTeamComparisonGameplayEffectComponent::CanGameplayEffectApply(const FActiv
 		return true;
 	}
 
-	const AActor* Instigator = GESpec.GetEffectContext().GetInstigator();
+	const FGameplayEffectContextHandle& Context = GESpec.GetEffectContext();
+	const AActor* Instigator = Context.GetInstigator();
 	if (!Instigator)
 	{
 		// require an instigator
 		return false;
 	}
 
+	if (AttitudeMask == FCommonTeamTypes::AllAttitudesMask && ComparisonMask == FCommonTeamTypes::AllComparisonsMask)
+	{
+		return true;
+	}
+
+	// resolve each team once, using the instigator team stored in the context if available
+	const FCommonGameplayEffectContext* CommonContext = FCommonGameplayEffectContext::Get(Context);
+	FGenericTeamId InstigatorTeamId;
+	if (CommonContext && CommonContext->HasInstigatorTeamId())
+	{
+		InstigatorTeamId = CommonContext->GetInstigatorTeamId();
+	}
+	else
+	{
+		InstigatorTeamId = TeamsComp->GetObjectGenericTeamId(Instigator);
+	}
+	const FGenericTeamId TargetTeamId = TeamsComp->GetObjectGenericTeamId(ActiveGEContainer.Owner->GetOwner());
+
 	if (AttitudeMask != FCommonTeamTypes::AllAttitudesMask)
 	{
-		const ETeamAttitude::Type Attitude = TeamsComp->GetAttitude(Instigator, ActiveGEContainer.Owner->GetOwner());
+		const ETeamAttitude::Type Attitude = TeamsComp->GetTeamAttitude(InstigatorTeamId, TargetTeamId);
 		if (!FCommonTeamTypes::MatchesAttitudeMask(Attitude, AttitudeMask))
 		{
 			return false;
@@ -47,7 +67,7 @@ bool UTeamComparisonGameplayEffectComponent::CanGameplayEffectApply(const FActiv
 
 	if (ComparisonMask != FCommonTeamTypes::AllComparisonsMask)
 	{
-		const ECommonTeamComparison Comparison = TeamsComp->CompareTeams(Instigator, ActiveGEContainer.Owner->GetOwner());
+		const ECommonTeamComparison Comparison = UCommonTeamsComponent::CompareTeamIds(InstigatorTeamId, TargetTeamId);
 		if (!FCommonTeamTypes::MatchesComparisonMask(Comparison, ComparisonMask))
 		{
 			return false;
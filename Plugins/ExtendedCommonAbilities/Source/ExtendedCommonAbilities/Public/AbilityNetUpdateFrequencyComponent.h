@@ -0,0 +1,84 @@
+﻿// Copyright Bohdon Sayre, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+#include "Components/ActorComponent.h"
+#include "AbilityNetUpdateFrequencyComponent.generated.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+struct FAbilityEndedData;
+struct FActiveGameplayEffect;
+struct FGameplayAbilitySpec;
+
+
+/**
+ * Adjusts the net update frequency of its owner based on ability system activity.
+ * The frequency is raised whenever replicated state of the owner's ability system is dirtied: effects are applied or removed,
+ * abilities change, or a UExtendedAttributeSet marks attributes dirty (requires a UExtendedAbilitySystemComponent).
+ * It drops to a low idle frequency when nothing has changed for a while. Only runs on the server.
+ * Other replicated changes, such as replicated loose tags, can call NotifyActivity directly.
+ */
+UCLASS(Blueprintable, Meta = (BlueprintSpawnableComponent))
+class EXTENDEDCOMMONABILITIES_API UAbilityNetUpdateFrequencyComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UAbilityNetUpdateFrequencyComponent(const FObjectInitializer& ObjectInitializer);
+
+	/** The net update frequency to use while the ability system is changing. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Meta = (ClampMin = "1"), Category = "Replication")
+	float ActiveNetUpdateFrequency;
+
+	/** The net update frequency to use after the ability system has been idle. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Meta = (ClampMin = "1"), Category = "Replication")
+	float IdleNetUpdateFrequency;
+
+	/** How long without any changes before dropping to the idle frequency. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Meta = (ClampMin = "0"), Category = "Replication")
+	float IdleDelay;
+
+	/** Force a net update when first becoming active, so that changes after being idle are sent immediately. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Replication")
+	bool bForceNetUpdateWhenActivated;
+
+	/** Notify that something relevant has changed, and raise the net update frequency. */
+	UFUNCTION(BlueprintCallable, Category = "Replication")
+	void NotifyActivity();
+
+	/** Return true if currently using the active net update frequency. */
+	UFUNCTION(BlueprintPure, Category = "Replication")
+	bool IsActive() const { return bIsActive; }
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+protected:
+	/** Ability system being monitored. */
+	UPROPERTY(Transient)
+	TObjectPtr<UAbilitySystemComponent> AbilitySystem;
+
+	/** The world time of the most recent activity. */
+	double LastActivityTime;
+
+	bool bIsActive;
+
+	FTimerHandle IdleTimerHandle;
+
+	void SetAbilitySystem(UAbilitySystemComponent* InAbilitySystem);
+
+	void SetNetUpdateFrequency(float NewFrequency);
+
+	/** Check whether the idle delay has passed, and either drop to the idle frequency or check again later. */
+	void OnIdleTimer();
+
+	void OnEffectApplied(UAbilitySystemComponent* Target, const FGameplayEffectSpec& SpecApplied, FActiveGameplayEffectHandle ActiveHandle);
+	void OnAnyEffectRemoved(const FActiveGameplayEffect& Effect);
+	void OnAttributeReplicationDirtied();
+	void OnAbilityActivated(UGameplayAbility* Ability);
+	void OnAbilityEnded(const FAbilityEndedData& EndedData);
+	void OnAbilitySpecDirtied(const FGameplayAbilitySpec& AbilitySpec);
+};
@@ -9,6 +9,7 @@
 #include "GameFramework/PlayerState.h"
 #include "AbilityPlayerState.generated.h"
 
+class UAbilityNetUpdateFrequencyComponent;
 class UExtendedAbilitySystemComponent;
 
 
@@ -26,6 +27,10 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	TObjectPtr<UExtendedAbilitySystemComponent> AbilitySystem;
 
+	/** Lowers the net update frequency while the ability system is idle. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	TObjectPtr<UAbilityNetUpdateFrequencyComponent> NetUpdateFrequencyComponent;
+
 public:
 	AAbilityPlayerState(const FObjectInitializer& ObjectInitializer);
 
@@ -42,6 +47,8 @@ public:
 	UFUNCTION(BlueprintPure, Category = "PlayerState")
 	int32 GetTeamId() const;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	DECLARE_MULTICAST_DELEGATE_ThreeParams(FTeamChangedDelegate, UObject* /*TeamAgent*/, int32 /*NewTeamId*/, int32 /*OldTeamId*/);
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FTeamChangedDynDelegate, UObject*, TeamAgent, int32, NewTeamId, int32, OldTeamId);
 
@@ -0,0 +1,21 @@
+﻿// Copyright Bohdon Sayre, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemGlobals.h"
+#include "CommonAbilitySystemGlobals.generated.h"
+
+
+/**
+ * Ability system globals that use FCommonGameplayEffectContext.
+ * Enable by setting AbilitySystemGlobalsClassName in the [/Script/GameplayAbilities.AbilitySystemGlobals] config section.
+ */
+UCLASS()
+class EXTENDEDCOMMONABILITIES_API UCommonAbilitySystemGlobals : public UAbilitySystemGlobals
+{
+	GENERATED_BODY()
+
+public:
+	virtual FGameplayEffectContext* AllocGameplayEffectContext() const override;
+};
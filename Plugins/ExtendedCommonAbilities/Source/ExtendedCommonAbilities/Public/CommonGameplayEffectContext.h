@@ -0,0 +1,50 @@
+﻿// Copyright Bohdon Sayre, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+#include "GenericTeamAgentInterface.h"
+#include "CommonGameplayEffectContext.generated.h"
+
+
+/**
+ * Gameplay effect context that stores the instigator's team when the instigator is set,
+ * so that team comparisons don't need to resolve it again for every target.
+ * Enabled by using UCommonAbilitySystemGlobals.
+ */
+USTRUCT()
+struct EXTENDEDCOMMONABILITIES_API FCommonGameplayEffectContext : public FGameplayEffectContext
+{
+	GENERATED_BODY()
+
+	/** Return the common effect context from a handle, if it is one. */
+	static FCommonGameplayEffectContext* Get(const FGameplayEffectContextHandle& Handle);
+
+	/** Return true if the instigator's team was stored when the instigator was set. */
+	bool HasInstigatorTeamId() const { return bHasInstigatorTeamId; }
+
+	/** Return the instigator's team at the time the instigator was set. */
+	FGenericTeamId GetInstigatorTeamId() const { return InstigatorTeamId; }
+
+	virtual void AddInstigator(AActor* InInstigator, AActor* InEffectCauser) override;
+	virtual UScriptStruct* GetScriptStruct() const override { return StaticStruct(); }
+	virtual FCommonGameplayEffectContext* Duplicate() const override;
+	virtual bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) override;
+
+protected:
+	/** The instigator's team, stored when the instigator is set. */
+	FGenericTeamId InstigatorTeamId = FGenericTeamId::NoTeam;
+
+	bool bHasInstigatorTeamId = false;
+};
+
+template <>
+struct TStructOpsTypeTraits<FCommonGameplayEffectContext> : public TStructOpsTypeTraitsBase2<FCommonGameplayEffectContext>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithCopy = true,
+	};
+};
@@ -28,6 +28,17 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Teams")
 	static void CompareTeams(const UObject* ObjectA, const UObject* ObjectB, TEnumAsByte<ETeamAttitude::Type>& Attitude, ECommonTeamComparison& Comparison);
 
+	/**
+	 * Return the actors that match a team attitude and comparison with an instigator, e.g. before applying effects to many targets.
+	 * All actors are returned if there is no teams component.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Teams")
+	static TArray<AActor*> FilterActorsByTeam(
+		const UObject* Instigator,
+		const TArray<AActor*>& Actors,
+		UPARAM(Meta = (Bitmask, BitmaskEnum = "/Script/AIModule.ETeamAttitude")) int32 AttitudeMask,
+		UPARAM(Meta = (Bitmask, BitmaskEnum = "/Script/ExtendedCommonAbilities.ECommonTeamComparison")) int32 ComparisonMask);
+
 	/** Convert a FGenericTeamId to an integer, returning INDEX_NONE if NoTeam. */
 	FORCEINLINE static int32 GenericTeamIdToInteger(const FGenericTeamId& InTeamId)
 	{
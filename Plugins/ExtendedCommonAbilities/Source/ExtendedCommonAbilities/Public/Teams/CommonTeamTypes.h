@@ -6,6 +6,8 @@
 #include "GenericTeamAgentInterface.h"
 #include "CommonTeamTypes.generated.h"
 
+class APlayerState;
+
 
 /**
  * Result of comparing two object's teams.
@@ -21,6 +23,19 @@ enum class ECommonTeamComparison : uint8
 	NoTeam,
 };
 
+/**
+ * The players that are currently on a team.
+ */
+USTRUCT(BlueprintType)
+struct EXTENDEDCOMMONABILITIES_API FCommonTeamRoster
+{
+	GENERATED_BODY()
+
+	/** The player states on the team, in no particular order. Destroyed player states are nulled by GC until pruned. */
+	UPROPERTY(BlueprintReadOnly, Category = "Teams")
+	TArray<TObjectPtr<APlayerState>> Members;
+};
+
 class FCommonTeamTypes
 {
 public:
@@ -8,7 +8,62 @@
 #include "Components/GameStateComponent.h"
 #include "CommonTeamsComponent.generated.h"
 
+class APlayerState;
 class UCommonTeamDef;
+class UCommonTeamsComponent;
+
+
+/**
+ * A cached team agent for an object, see UCommonTeamsComponent::FindTeamInterfaceForObject.
+ */
+struct FCommonCachedTeamAgent
+{
+	enum class ESource : uint8
+	{
+		/** The agent never changes for the object, e.g. the object itself. */
+		Object,
+		/** The agent was resolved from a pawn's player state. */
+		Pawn,
+		/** The agent was resolved from a controller's player state. */
+		Controller,
+	};
+
+	/** The team agent, which may be null if the object has no team. */
+	IGenericTeamAgentInterface* Agent = nullptr;
+
+	/** The object implementing the team agent, used to check that Agent is still valid. */
+	TWeakObjectPtr<const UObject> AgentObject;
+
+	/** The player state at the time the agent was resolved, used to detect possession changes. */
+	const APlayerState* PlayerState = nullptr;
+
+	ESource Source = ESource::Object;
+};
+
+
+/**
+ * Evaluates team attitude and comparison masks for targets against a single instigator team.
+ * Results are cached per target team, so filtering many targets only resolves each target's team id.
+ */
+struct EXTENDEDCOMMONABILITIES_API FCommonTeamFilter
+{
+	FCommonTeamFilter(const UCommonTeamsComponent& InTeamsComponent, FGenericTeamId InInstigatorTeamId, uint8 InAttitudeMask, uint8 InComparisonMask);
+
+	/** Return true if a target team passes the filter. */
+	bool PassesTeam(FGenericTeamId TeamId);
+
+	/** Return true if a target object's team passes the filter. */
+	bool PassesObject(const UObject* Object);
+
+private:
+	const UCommonTeamsComponent& TeamsComponent;
+	FGenericTeamId InstigatorTeamId;
+	uint8 AttitudeMask;
+	uint8 ComparisonMask;
+
+	/** Cached result for each target team id, 0 if not yet evaluated, 1 if failed, 2 if passed. */
+	uint8 ResultsByTeam[256];
+};
 
 
 /**
@@ -33,10 +88,50 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Teams")
 	int32 GetLeastPopulatedTeam() const;
 
+	/** Return the roster of players on a team. Members may contain null entries for destroyed player states. */
+	const FCommonTeamRoster* GetTeamRoster(int32 TeamId) const { return TeamRosters.Find(TeamId); }
+
+	/** Return all players on a team. */
+	UFUNCTION(BlueprintPure, Category = "Teams")
+	TArray<APlayerState*> GetTeamMembers(int32 TeamId) const;
+
+	/** Return the number of players on a team. */
+	UFUNCTION(BlueprintPure, Category = "Teams")
+	int32 GetTeamMemberCount(int32 TeamId) const;
+
+	/**
+	 * Update the roster for a player's current team.
+	 * Called automatically when an AAbilityPlayerState changes teams, or when assigning teams on the server.
+	 */
+	void UpdatePlayerTeam(APlayerState* PlayerState);
+
+	/** Remove a player from the team rosters, e.g. when logging out. */
+	void RemovePlayer(APlayerState* PlayerState);
+
+	/** Remove destroyed player states from the team rosters. */
+	void PruneTeamRosters();
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FTeamRosterChangedDelegate, int32 /*TeamId*/);
+
+	/** Called when a player joins or leaves a team. */
+	FTeamRosterChangedDelegate OnTeamRosterChangedEvent;
+
 	/** Find and return the team agent interface to use for an object. */
 	virtual IGenericTeamAgentInterface* GetTeamInterfaceForObject(UObject* Object) const;
 	virtual const IGenericTeamAgentInterface* GetTeamInterfaceForObject(const UObject* Object) const;
 
+	/**
+	 * Return the team agent interface to use for an object, using a cached result when possible.
+	 * Pawns and controllers are re-resolved when their player state changes, e.g. after possession.
+	 */
+	const IGenericTeamAgentInterface* FindTeamInterfaceForObject(const UObject* Object) const;
+
+	/** Clear all cached team agents, e.g. after changing how team agents are resolved. */
+	void ClearTeamAgentCache();
+
+	/** Clear cached attitudes, e.g. after changing the FGenericTeamId attitude solver. */
+	void ClearAttitudeCache();
+
 	/** Return the generic team id for an actor or object. */
 	virtual FGenericTeamId GetObjectGenericTeamId(const UObject* Object) const;
 
@@ -59,6 +154,19 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Teams", meta = (DefaultToSelf = "ObjectA"))
 	ECommonTeamComparison CompareTeams(const UObject* ObjectA, const UObject* ObjectB) const;
 
+	/** Return the attitude of one team towards another, or neutral if either has no team. */
+	ETeamAttitude::Type GetTeamAttitude(FGenericTeamId TeamIdA, FGenericTeamId TeamIdB) const;
+
+	/** Compare two team ids. */
+	static ECommonTeamComparison CompareTeamIds(FGenericTeamId TeamIdA, FGenericTeamId TeamIdB);
+
+	/**
+	 * Filter actors by their team attitude and comparison with an instigator, resolving the instigator's team only once.
+	 * Actors that pass are added to OutActors, in their original order.
+	 */
+	void FilterActorsByTeam(const UObject* Instigator, TConstArrayView<AActor*> Actors, uint8 AttitudeMask, uint8 ComparisonMask,
+	                        TArray<AActor*>& OutActors) const;
+
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
@@ -66,6 +174,25 @@ protected:
 	/** Called during BeginPlay to start setting up teams. */
 	virtual void StartTeamSetup();
 
+	/**
+	 * The players on each team, updated as players change teams.
+	 * Player states are not guaranteed to be removed (e.g. on clients), so GC clears destroyed ones and reads skip them.
+	 */
+	UPROPERTY()
+	TMap<int32, FCommonTeamRoster> TeamRosters;
+
+	/** The roster each player is currently in. */
+	TMap<TObjectKey<APlayerState>, int32> PlayerTeams;
+
+	/** Cached team agents for objects, see FindTeamInterfaceForObject. */
+	mutable TMap<TObjectKey<UObject>, FCommonCachedTeamAgent> TeamAgentCache;
+
+	/** The cache size at which to remove entries for destroyed objects. */
+	mutable int32 TeamAgentCachePruneSize = 256;
+
+	/** Cached attitudes of each team towards each other team, indexed by TeamA * 256 + TeamB. */
+	mutable TArray<uint8> AttitudeCache;
+
 	/** Return which team a player should be assigned to. */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Teams")
 	int32 SelectTeamForPlayer(APlayerState* PlayerState);
@@ -79,5 +206,8 @@ protected:
 
 	/** Called when a player logs in. */
 	virtual void OnPlayerPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
+
+	/** Called when a player logs out. */
+	virtual void OnPlayerLogout(AGameModeBase* GameMode, AController* Exiting);
 #endif
 };
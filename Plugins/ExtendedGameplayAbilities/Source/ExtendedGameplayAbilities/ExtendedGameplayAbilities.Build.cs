@@ -25,6 +25,7 @@ public class ExtendedGameplayAbilities : ModuleRules
 		{
 			"CoreUObject",
 			"Engine",
+			"NetCore",
 			"Settings",
 			"Slate",
 			"SlateCore",
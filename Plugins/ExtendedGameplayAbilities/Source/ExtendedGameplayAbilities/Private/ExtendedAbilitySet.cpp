@@ -5,6 +5,7 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemLog.h"
 #include "AttributeSet.h"
+#include "ExtendedAttributeSet.h"
 
 
 // FExtendedAbilitySetHandles
@@ -73,6 +74,14 @@ FExtendedAbilitySetHandles UExtendedAbilitySet::GiveToAbilitySystem(UAbilitySyst
 		}
 
 		UAttributeSet* NewSet = NewObject<UAttributeSet>(AbilitySystem->GetOwner(), SetToGrant.AttributeSet);
+
+		// initialize values before adding, so they replicate with the new set
+		UExtendedAttributeSet* ExtendedSet = Cast<UExtendedAttributeSet>(NewSet);
+		if (ExtendedSet && !SetToGrant.InitRow.IsNull())
+		{
+			ExtendedSet->InitFromDataTableRow(SetToGrant.InitRow);
+		}
+
 		AbilitySystem->AddSpawnedAttribute(NewSet);
 
 		Result.AddAttributeSet(NewSet);
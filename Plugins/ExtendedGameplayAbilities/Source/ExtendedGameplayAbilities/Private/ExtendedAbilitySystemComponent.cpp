@@ -5,6 +5,17 @@
 #include "ExtendedAbilitySet.h"
 #include "ExtendedAbilityTagRelationshipMapping.h"
 #include "ExtendedGameplayAbility.h"
+#include "GameplayEffect.h"
+
+
+namespace ExtendedAbilitySystemComponent
+{
+	/** Gameplay cue tags added by each effect class, see GetEffectGameplayCueTags. */
+	TMap<TObjectKey<UGameplayEffect>, FGameplayTagContainer> EffectGameplayCueTags;
+
+	/** The cache size at which to remove entries for unloaded effect classes. */
+	int32 EffectGameplayCueTagsPruneSize = 256;
+}
 
 
 UExtendedAbilitySystemComponent::UExtendedAbilitySystemComponent(const FObjectInitializer& ObjectInitializer)
@@ -15,9 +26,14 @@ UExtendedAbilitySystemComponent::UExtendedAbilitySystemComponent(const FObjectIn
 FGameplayEffectSpecSet UExtendedAbilitySystemComponent::MakeEffectSpecSet(const FGameplayEffectSet& EffectSet, float Level)
 {
 	FGameplayEffectSpecSet SpecSet;
+	SpecSet.EffectSpecs.Reserve(EffectSet.Effects.Num());
+
+	// all specs share one context
+	SpecSet.Context = MakeEffectContext();
+
 	for (const TSubclassOf<UGameplayEffect> GameplayEffect : EffectSet.Effects)
 	{
-		FGameplayEffectSpecHandle Spec = MakeOutgoingSpec(GameplayEffect, Level, MakeEffectContext());
+		FGameplayEffectSpecHandle Spec = MakeOutgoingSpec(GameplayEffect, Level, SpecSet.Context);
 		if (Spec.IsValid())
 		{
 			// assign set-by-caller magnitudes
@@ -33,6 +49,15 @@ FGameplayEffectSpecSet UExtendedAbilitySystemComponent::MakeEffectSpecSet(const
 	return SpecSet;
 }
 
+void UExtendedAbilitySystemComponent::SetAbilityTagRelationshipMapping(UExtendedAbilityTagRelationshipMapping* NewMapping)
+{
+	if (AbilityTagRelationshipMapping != NewMapping)
+	{
+		AbilityTagRelationshipMapping = NewMapping;
+		OnAbilityTagRelationshipMappingChangedEvent.Broadcast();
+	}
+}
+
 TArray<FActiveGameplayEffectHandle> UExtendedAbilitySystemComponent::ApplyGameplayEffectSpecSetToSelf(const FGameplayEffectSpecSet& EffectSpecSet)
 {
 	TArray<FActiveGameplayEffectHandle> Result;
@@ -47,6 +72,82 @@ TArray<FActiveGameplayEffectHandle> UExtendedAbilitySystemComponent::ApplyGamepl
 	return Result;
 }
 
+TConstArrayView<FActiveGameplayEffectHandle> UExtendedAbilitySystemComponent::GetActiveEffectsBySourceObject(const UObject* SourceObject) const
+{
+	if (const TArray<FActiveGameplayEffectHandle>* Handles = ActiveEffectsBySourceObject.Find(SourceObject))
+	{
+		return *Handles;
+	}
+	return TConstArrayView<FActiveGameplayEffectHandle>();
+}
+
+int32 UExtendedAbilitySystemComponent::RemoveActiveEffectsBySourceObject(const UObject* SourceObject, int32 StacksToRemove)
+{
+	const TArray<FActiveGameplayEffectHandle>* Handles = ActiveEffectsBySourceObject.Find(SourceObject);
+	if (!Handles)
+	{
+		return 0;
+	}
+
+	// copy, since removing effects updates the index
+	const TArray<FActiveGameplayEffectHandle> HandlesToRemove = *Handles;
+
+	int32 NumRemoved = 0;
+	for (const FActiveGameplayEffectHandle& Handle : HandlesToRemove)
+	{
+		if (RemoveActiveGameplayEffect(Handle, StacksToRemove))
+		{
+			++NumRemoved;
+		}
+	}
+	return NumRemoved;
+}
+
+TConstArrayView<FActiveGameplayEffectHandle> UExtendedAbilitySystemComponent::GetActiveEffectsGrantingGameplayCue(const FGameplayTag& GameplayCueTag) const
+{
+	if (const TArray<FActiveGameplayEffectHandle>* Handles = ActiveEffectsByGameplayCue.Find(GameplayCueTag))
+	{
+		return *Handles;
+	}
+	return TConstArrayView<FActiveGameplayEffectHandle>();
+}
+
+FGameplayTagContainer UExtendedAbilitySystemComponent::GetEffectGameplayCueTags(const UGameplayEffect* EffectDef)
+{
+	check(IsInGameThread());
+
+	TMap<TObjectKey<UGameplayEffect>, FGameplayTagContainer>& Cache = ExtendedAbilitySystemComponent::EffectGameplayCueTags;
+	if (const FGameplayTagContainer* CachedCueTags = Cache.Find(EffectDef))
+	{
+		return *CachedCueTags;
+	}
+
+	int32& PruneSize = ExtendedAbilitySystemComponent::EffectGameplayCueTagsPruneSize;
+	if (Cache.Num() >= PruneSize)
+	{
+		for (auto It = Cache.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		PruneSize = FMath::Max(256, Cache.Num() * 2);
+	}
+
+	FGameplayTagContainer CueTags;
+	if (EffectDef)
+	{
+		for (const FGameplayEffectCue& EffectCue : EffectDef->GameplayCues)
+		{
+			CueTags.AppendTags(EffectCue.GameplayCueTags);
+		}
+	}
+
+	// include parents so that lookups match the same tags as FGameplayTagContainer::HasTag
+	return Cache.Add(EffectDef, CueTags.GetGameplayTagParents());
+}
+
 void UExtendedAbilitySystemComponent::CancelAbilitiesWithState(FGameplayTagContainer WithStateTags, UGameplayAbility* IgnoreAbility)
 {
 	const FGameplayAbilityActorInfo* ActorInfo = AbilityActorInfo.Get();
@@ -90,6 +191,10 @@ void UExtendedAbilitySystemComponent::InitializeComponent()
 {
 	Super::InitializeComponent();
 
+	// index active effects, before any startup effects are applied
+	OnActiveGameplayEffectAddedDelegateToSelf.AddUObject(this, &UExtendedAbilitySystemComponent::OnActiveEffectAdded);
+	OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &UExtendedAbilitySystemComponent::OnActiveEffectRemoved);
+
 	// apply default tags
 	for (const FGameplayTag& DefaultTag : DefaultTags)
 	{
@@ -124,6 +229,56 @@ void UExtendedAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& Abil
 	}
 }
 
+void UExtendedAbilitySystemComponent::OnActiveEffectAdded(UAbilitySystemComponent* AbilitySystem, const FGameplayEffectSpec& Spec,
+                                                          FActiveGameplayEffectHandle Handle)
+{
+	if (const UObject* SourceObject = Spec.GetContext().GetSourceObject())
+	{
+		ActiveEffectsBySourceObject.FindOrAdd(SourceObject).Add(Handle);
+		SourceObjectsByActiveEffect.Add(Handle, SourceObject);
+	}
+
+	FGameplayTagContainer CueTags = GetEffectGameplayCueTags(Spec.Def);
+	if (!CueTags.IsEmpty())
+	{
+		for (const FGameplayTag& CueTag : CueTags)
+		{
+			ActiveEffectsByGameplayCue.FindOrAdd(CueTag).Add(Handle);
+		}
+		GameplayCueTagsByActiveEffect.Add(Handle, MoveTemp(CueTags));
+	}
+}
+
+void UExtendedAbilitySystemComponent::OnActiveEffectRemoved(const FActiveGameplayEffect& ActiveEffect)
+{
+	TObjectKey<UObject> SourceObjectKey;
+	if (SourceObjectsByActiveEffect.RemoveAndCopyValue(ActiveEffect.Handle, SourceObjectKey))
+	{
+		if (TArray<FActiveGameplayEffectHandle>* Handles = ActiveEffectsBySourceObject.Find(SourceObjectKey))
+		{
+			Handles->RemoveSingleSwap(ActiveEffect.Handle, EAllowShrinking::No);
+			if (Handles->IsEmpty())
+			{
+				ActiveEffectsBySourceObject.Remove(SourceObjectKey);
+			}
+		}
+	}
+
+	FGameplayTagContainer CueTags;
+	GameplayCueTagsByActiveEffect.RemoveAndCopyValue(ActiveEffect.Handle, CueTags);
+	for (const FGameplayTag& CueTag : CueTags)
+	{
+		if (TArray<FActiveGameplayEffectHandle>* Handles = ActiveEffectsByGameplayCue.Find(CueTag))
+		{
+			Handles->RemoveSingleSwap(ActiveEffect.Handle, EAllowShrinking::No);
+			if (Handles->IsEmpty())
+			{
+				ActiveEffectsByGameplayCue.Remove(CueTag);
+			}
+		}
+	}
+}
+
 void UExtendedAbilitySystemComponent::ApplyAbilityBlockAndCancelTags(const FGameplayTagContainer& AbilityTags, UGameplayAbility* RequestingAbility,
                                                                      bool bEnableBlockTags, const FGameplayTagContainer& BlockTags,
                                                                      bool bExecuteCancelTags, const FGameplayTagContainer& CancelTags)
@@ -141,6 +296,26 @@ void UExtendedAbilitySystemComponent::ApplyAbilityBlockAndCancelTags(const FGame
 	}
 }
 
+void UExtendedAbilitySystemComponent::BlockAbilitiesWithTags(const FGameplayTagContainer& Tags)
+{
+	Super::BlockAbilitiesWithTags(Tags);
+
+	if (!Tags.IsEmpty())
+	{
+		OnAbilityBlockTagsChangedEvent.Broadcast(Tags);
+	}
+}
+
+void UExtendedAbilitySystemComponent::UnBlockAbilitiesWithTags(const FGameplayTagContainer& Tags)
+{
+	Super::UnBlockAbilitiesWithTags(Tags);
+
+	if (!Tags.IsEmpty())
+	{
+		OnAbilityBlockTagsChangedEvent.Broadcast(Tags);
+	}
+}
+
 void UExtendedAbilitySystemComponent::GetAdditionalActivationTagRequirements(const FGameplayTagContainer& AbilityTags,
                                                                              FGameplayTagContainer& OutRequiredTags,
                                                                              FGameplayTagContainer& OutBlockedTags) const
@@ -6,13 +6,79 @@
 #include "AbilitySystemGlobals.h"
 #include "DataRegistrySubsystem.h"
 #include "ExtendedAbilitySystemComponent.h"
+#include "GameStateComponentSubsystem.h"
 #include "Engine/Engine.h"
-#include "GameFramework/GameStateBase.h"
 #include "Phases/AbilityGamePhaseComponent.h"
 #include "Targeting/ExtendedTargetingSystemTypes.h"
 #include "Targeting/GameplayAbilityTargetActor_TargetingPreset.h"
 
 
+namespace ExtendedAbilitySystemStatics
+{
+	/** Update the source object for all effect specs in a set, this is a lasting change for those specs. */
+	void SetSourceObjectForSet(const FGameplayEffectSpecSet& EffectSpecSet, const UObject* SourceObject)
+	{
+		if (!SourceObject)
+		{
+			return;
+		}
+
+		EffectSpecSet.ForEachContext([SourceObject](FGameplayEffectContextHandle& EffectContext)
+		{
+			// 'Add' is misleading here, there is only one source object and this replaces it
+			EffectContext.AddSourceObject(SourceObject);
+		});
+	}
+
+	/** Apply a spec set to actors that haven't been seen yet, adding each actor to SeenActors. */
+	TArray<FGameplayEffectSpecSetTargetHandles> ApplyEffectSpecSetToUniqueActors(const TArray<AActor*>& Actors, const FGameplayEffectSpecSet& EffectSpecSet,
+	                                                                             TSet<const AActor*>& SeenActors)
+	{
+		TArray<FGameplayEffectSpecSetTargetHandles> Result;
+		Result.Reserve(Actors.Num());
+
+		for (AActor* Actor : Actors)
+		{
+			bool bIsAlreadySeen = false;
+			SeenActors.Add(Actor, &bIsAlreadySeen);
+			if (bIsAlreadySeen)
+			{
+				continue;
+			}
+
+			if (UExtendedAbilitySystemComponent* ExtendedAbilitySystem = UExtendedAbilitySystemStatics::GetExtendedAbilitySystemComponent(Actor))
+			{
+				FGameplayEffectSpecSetTargetHandles& TargetHandles = Result.AddDefaulted_GetRef();
+				TargetHandles.Actor = Actor;
+				TargetHandles.EffectHandles = ExtendedAbilitySystem->ApplyGameplayEffectSpecSetToSelf(EffectSpecSet);
+			}
+		}
+
+		return Result;
+	}
+
+	/** Remove all effects applied by a source object from an actor, using the source object index if possible. */
+	int32 RemoveEffectsBySourceObject(AActor* Actor, const UObject* SourceObject)
+	{
+		UAbilitySystemComponent* AbilitySystem = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Actor);
+		if (!AbilitySystem)
+		{
+			return 0;
+		}
+
+		if (UExtendedAbilitySystemComponent* ExtendedAbilitySystem = Cast<UExtendedAbilitySystemComponent>(AbilitySystem))
+		{
+			return ExtendedAbilitySystem->RemoveActiveEffectsBySourceObject(SourceObject);
+		}
+
+		FGameplayEffectQuery EffectQuery;
+		EffectQuery.EffectSource = SourceObject;
+
+		return AbilitySystem->RemoveActiveEffects(EffectQuery);
+	}
+}
+
+
 UExtendedAbilitySystemComponent* UExtendedAbilitySystemStatics::GetExtendedAbilitySystemComponent(AActor* Actor)
 {
 	return Cast<UExtendedAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Actor));
@@ -54,10 +120,10 @@ AGameplayAbilityTargetActor_TargetingPreset* UExtendedAbilitySystemStatics::GetT
 	return nullptr;
 }
 
-FGameplayEffectSpecSet UExtendedAbilitySystemStatics::AssignTagSetByCallerMagnitudeForSet(FGameplayEffectSpecSet EffectSpecSet, FGameplayTag DataTag,
+FGameplayEffectSpecSet UExtendedAbilitySystemStatics::AssignTagSetByCallerMagnitudeForSet(const FGameplayEffectSpecSet& EffectSpecSet, FGameplayTag DataTag,
                                                                                           float Magnitude)
 {
-	for (FGameplayEffectSpecHandle SpecHandle : EffectSpecSet.EffectSpecs)
+	for (const FGameplayEffectSpecHandle& SpecHandle : EffectSpecSet.EffectSpecs)
 	{
 		if (FGameplayEffectSpec* Spec = SpecHandle.Data.Get())
 		{
@@ -67,27 +133,22 @@ FGameplayEffectSpecSet UExtendedAbilitySystemStatics::AssignTagSetByCallerMagnit
 	return EffectSpecSet;
 }
 
-FGameplayEffectSpecSet UExtendedAbilitySystemStatics::AddContextHitResultForSet(FGameplayEffectSpecSet EffectSpecSet, FHitResult HitResult, bool bReset)
+FGameplayEffectSpecSet UExtendedAbilitySystemStatics::AddContextHitResultForSet(const FGameplayEffectSpecSet& EffectSpecSet, const FHitResult& HitResult,
+                                                                                bool bReset)
 {
-	for (FGameplayEffectSpecHandle SpecHandle : EffectSpecSet.EffectSpecs)
+	EffectSpecSet.ForEachContext([&HitResult, bReset](FGameplayEffectContextHandle& EffectContext)
 	{
-		if (FGameplayEffectSpec* Spec = SpecHandle.Data.Get())
-		{
-			Spec->GetContext().AddHitResult(HitResult, bReset);
-		}
-	}
+		EffectContext.AddHitResult(HitResult, bReset);
+	});
 	return EffectSpecSet;
 }
 
-FGameplayEffectSpecSet UExtendedAbilitySystemStatics::SetContextOriginForSet(FGameplayEffectSpecSet EffectSpecSet, FVector Origin)
+FGameplayEffectSpecSet UExtendedAbilitySystemStatics::SetContextOriginForSet(const FGameplayEffectSpecSet& EffectSpecSet, FVector Origin)
 {
-	for (FGameplayEffectSpecHandle SpecHandle : EffectSpecSet.EffectSpecs)
+	EffectSpecSet.ForEachContext([&Origin](FGameplayEffectContextHandle& EffectContext)
 	{
-		if (FGameplayEffectSpec* Spec = SpecHandle.Data.Get())
-		{
-			Spec->GetContext().AddOrigin(Origin);
-		}
-	}
+		EffectContext.AddOrigin(Origin);
+	});
 	return EffectSpecSet;
 }
 
@@ -101,18 +162,7 @@ TArray<FActiveGameplayEffectHandle> UExtendedAbilitySystemStatics::ApplyEffectSp
 		return TArray<FActiveGameplayEffectHandle>();
 	}
 
-	if (SourceObject)
-	{
-		// update the source object for all effect specs, this is a lasting change for those specs
-		for (const FGameplayEffectSpecHandle& SpecHandle : EffectSpecSet.EffectSpecs)
-		{
-			if (SpecHandle.IsValid())
-			{
-				// 'Add' is misleading here, there is only one source object and this replaces it
-				SpecHandle.Data->GetContext().AddSourceObject(SourceObject);
-			}
-		}
-	}
+	ExtendedAbilitySystemStatics::SetSourceObjectForSet(EffectSpecSet, SourceObject);
 
 	bSuccess = true;
 	return ExtendedAbilitySystem->ApplyGameplayEffectSpecSetToSelf(EffectSpecSet);
@@ -136,6 +186,39 @@ TArray<FActiveGameplayEffectHandle> UExtendedAbilitySystemStatics::ApplyEffectSp
 	return Result;
 }
 
+TArray<FGameplayEffectSpecSetTargetHandles> UExtendedAbilitySystemStatics::ApplyEffectSpecSetToActors(const TArray<AActor*>& Actors,
+                                                                                                    const FGameplayEffectSpecSet& EffectSpecSet,
+                                                                                                    const UObject* SourceObject)
+{
+	ExtendedAbilitySystemStatics::SetSourceObjectForSet(EffectSpecSet, SourceObject);
+
+	TSet<const AActor*> SeenActors;
+	SeenActors.Reserve(Actors.Num());
+	return ExtendedAbilitySystemStatics::ApplyEffectSpecSetToUniqueActors(Actors, EffectSpecSet, SeenActors);
+}
+
+TArray<FGameplayEffectSpecSetTargetHandles> UExtendedAbilitySystemStatics::ApplyEffectSpecSetToActorsOnce(const TArray<AActor*>& Actors,
+                                                                                                        const FGameplayEffectSpecSet& EffectSpecSet,
+                                                                                                        const UObject* SourceObject,
+                                                                                                        TArray<AActor*>& AffectedActors)
+{
+	ExtendedAbilitySystemStatics::SetSourceObjectForSet(EffectSpecSet, SourceObject);
+
+	// previously affected actors are treated as already seen
+	TSet<const AActor*> SeenActors;
+	SeenActors.Reserve(AffectedActors.Num() + Actors.Num());
+	SeenActors.Append(AffectedActors);
+
+	TArray<FGameplayEffectSpecSetTargetHandles> Result = ExtendedAbilitySystemStatics::ApplyEffectSpecSetToUniqueActors(Actors, EffectSpecSet, SeenActors);
+
+	AffectedActors.Reserve(AffectedActors.Num() + Result.Num());
+	for (const FGameplayEffectSpecSetTargetHandles& TargetHandles : Result)
+	{
+		AffectedActors.Add(TargetHandles.Actor);
+	}
+	return Result;
+}
+
 int32 UExtendedAbilitySystemStatics::RemoveEffectsFromActorBySourceObject(AActor* Actor, const UObject* SourceObject, TArray<AActor*>& AffectedActors)
 {
 	if (AffectedActors.Contains(Actor))
@@ -143,15 +226,24 @@ int32 UExtendedAbilitySystemStatics::RemoveEffectsFromActorBySourceObject(AActor
 		AffectedActors.Remove(Actor);
 	}
 
-	if (UAbilitySystemComponent* AbilitySystem = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Actor))
+	return ExtendedAbilitySystemStatics::RemoveEffectsBySourceObject(Actor, SourceObject);
+}
+
+int32 UExtendedAbilitySystemStatics::RemoveEffectsFromActorsBySourceObject(const TArray<AActor*>& Actors, const UObject* SourceObject,
+                                                                           TArray<AActor*>& AffectedActors)
+{
+	const TSet<AActor*> ActorSet(Actors);
+	AffectedActors.RemoveAll([&ActorSet](AActor* Actor)
 	{
-		FGameplayEffectQuery EffectQuery;
-		EffectQuery.EffectSource = SourceObject;
+		return ActorSet.Contains(Actor);
+	});
 
-		return AbilitySystem->RemoveActiveEffects(EffectQuery);
+	int32 NumRemoved = 0;
+	for (AActor* Actor : ActorSet)
+	{
+		NumRemoved += ExtendedAbilitySystemStatics::RemoveEffectsBySourceObject(Actor, SourceObject);
 	}
-
-	return 0;
+	return NumRemoved;
 }
 
 TArray<FActiveGameplayEffectHandle> UExtendedAbilitySystemStatics::GetActiveEffectsGrantingGameplayCue(UAbilitySystemComponent* AbilitySystem,
@@ -162,6 +254,11 @@ TArray<FActiveGameplayEffectHandle> UExtendedAbilitySystemStatics::GetActiveEffe
 		return TArray<FActiveGameplayEffectHandle>();
 	}
 
+	if (const UExtendedAbilitySystemComponent* ExtendedAbilitySystem = Cast<UExtendedAbilitySystemComponent>(AbilitySystem))
+	{
+		return TArray<FActiveGameplayEffectHandle>(ExtendedAbilitySystem->GetActiveEffectsGrantingGameplayCue(GameplayCueTag));
+	}
+
 	FGameplayEffectQuery Query;
 	Query.CustomMatchDelegate = FActiveGameplayEffectQueryCustomMatch::CreateLambda([&GameplayCueTag](const FActiveGameplayEffect& ActiveEffect)
 	{
@@ -289,12 +386,5 @@ float UExtendedAbilitySystemStatics::GetDataRegistryValue(FDataRegistryId Id, fl
 
 UAbilityGamePhaseComponent* UExtendedAbilitySystemStatics::GetAbilityGamePhaseComponent(const UObject* WorldContextObject)
 {
-	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
-	{
-		if (const AGameStateBase* GameState = World->GetGameState())
-		{
-			return GameState->FindComponentByClass<UAbilityGamePhaseComponent>();
-		}
-	}
-	return nullptr;
+	return UGameStateComponentSubsystem::FindComponent<UAbilityGamePhaseComponent>(WorldContextObject);
 }
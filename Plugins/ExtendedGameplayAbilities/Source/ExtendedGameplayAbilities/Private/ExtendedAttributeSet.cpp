@@ -4,19 +4,450 @@
 #include "ExtendedAttributeSet.h"
 
 #include "AbilitySystemComponent.h"
+#include "AbilitySystemLog.h"
+#include "ExtendedAbilitySystemComponent.h"
 #include "ExtendedAbilitySystemStatics.h"
+#include "Engine/CurveTable.h"
+#include "Net/UnrealNetwork.h"
 
 
+namespace ExtendedAttributeSet
+{
+	/** Rules for each attribute set class, built while constructing class default objects, which may happen during async loading. */
+	TMap<TObjectKey<UClass>, TUniquePtr<FExtendedAttributeSetRules>> RulesByClass;
+	FCriticalSection RulesByClassLock;
+
+	int32 Quantize(float Value, float Step)
+	{
+		return static_cast<int32>(FMath::Clamp<double>(FMath::RoundToDouble(Value / Step), MIN_int32, MAX_int32));
+	}
+
+	bool IsQuantizedEqual(float A, float B, float Step)
+	{
+		return Step > 0.f ? Quantize(A, Step) == Quantize(B, Step) : A == B;
+	}
+
+	void SerializeQuantized(FArchive& Ar, float& Value, float Step)
+	{
+		if (Step <= 0.f)
+		{
+			Ar << Value;
+			return;
+		}
+
+		// zigzag encode so that small negative values also pack into few bytes
+		uint32 Packed = 0;
+		if (Ar.IsSaving())
+		{
+			const int32 Quantized = Quantize(Value, Step);
+			Packed = (static_cast<uint32>(Quantized) << 1) ^ static_cast<uint32>(Quantized >> 31);
+		}
+		Ar.SerializeIntPacked(Packed);
+		if (Ar.IsLoading())
+		{
+			const int32 Quantized = static_cast<int32>(Packed >> 1) ^ -static_cast<int32>(Packed & 1);
+			Value = static_cast<float>(Quantized * static_cast<double>(Step));
+		}
+	}
+}
+
+
+// FExtendedCompactAttributeData
+// -----------------------------
+
+const FExtendedAttributeSetRules* FExtendedCompactAttributeData::GetRules() const
+{
+	return AttributeSetClass ? UExtendedAttributeSet::FindRulesForClass(AttributeSetClass) : nullptr;
+}
+
+bool FExtendedCompactAttributeData::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	UObject* ClassObject = const_cast<UClass*>(AttributeSetClass.Get());
+	if (!Map || !Map->SerializeObject(Ar, UClass::StaticClass(), ClassObject))
+	{
+		bOutSuccess = false;
+		return true;
+	}
+
+	if (Ar.IsLoading())
+	{
+		AttributeSetClass = Cast<UClass>(ClassObject);
+	}
+
+	const FExtendedAttributeSetRules* Rules = GetRules();
+	if (!Rules || !Rules->bCompactReplication)
+	{
+		// the layout is unknown without the class rules
+		bOutSuccess = false;
+		return true;
+	}
+
+	const int32 Num = Rules->CompactAttributes.Num();
+	if (Ar.IsLoading())
+	{
+		BaseValues.SetNum(Num);
+		CurrentValues.SetNum(Num);
+	}
+
+	// two bits per attribute: base differs from default, and current differs from base
+	uint64 Mask = 0;
+	if (Ar.IsSaving())
+	{
+		for (int32 Idx = 0; Idx < Num; ++Idx)
+		{
+			const float Step = Rules->CompactQuantizationSteps[Idx];
+			if (!ExtendedAttributeSet::IsQuantizedEqual(BaseValues[Idx], Rules->CompactDefaultValues[Idx], Step))
+			{
+				Mask |= 1ull << (Idx * 2);
+			}
+			if (!ExtendedAttributeSet::IsQuantizedEqual(CurrentValues[Idx], BaseValues[Idx], Step))
+			{
+				Mask |= 1ull << (Idx * 2 + 1);
+			}
+		}
+	}
+	Ar.SerializeBits(&Mask, Num * 2);
+
+	for (int32 Idx = 0; Idx < Num; ++Idx)
+	{
+		const float Step = Rules->CompactQuantizationSteps[Idx];
+
+		if (Mask & (1ull << (Idx * 2)))
+		{
+			ExtendedAttributeSet::SerializeQuantized(Ar, BaseValues[Idx], Step);
+		}
+		else if (Ar.IsLoading())
+		{
+			BaseValues[Idx] = Rules->CompactDefaultValues[Idx];
+		}
+
+		if (Mask & (1ull << (Idx * 2 + 1)))
+		{
+			ExtendedAttributeSet::SerializeQuantized(Ar, CurrentValues[Idx], Step);
+		}
+		else if (Ar.IsLoading())
+		{
+			CurrentValues[Idx] = BaseValues[Idx];
+		}
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FExtendedCompactAttributeData::operator==(const FExtendedCompactAttributeData& Other) const
+{
+	if (BaseValues.Num() != Other.BaseValues.Num() || CurrentValues.Num() != Other.CurrentValues.Num())
+	{
+		return false;
+	}
+
+	const FExtendedAttributeSetRules* Rules = GetRules();
+	for (int32 Idx = 0; Idx < BaseValues.Num(); ++Idx)
+	{
+		const float Step = Rules && Rules->CompactQuantizationSteps.IsValidIndex(Idx) ? Rules->CompactQuantizationSteps[Idx] : 0.f;
+		if (!ExtendedAttributeSet::IsQuantizedEqual(BaseValues[Idx], Other.BaseValues[Idx], Step) ||
+			!ExtendedAttributeSet::IsQuantizedEqual(CurrentValues[Idx], Other.CurrentValues[Idx], Step))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+// UExtendedAttributeSet
+// ---------------------
+
+void UExtendedAttributeSet::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	Rules = FindRulesForClass(GetClass());
+
+	if (Rules && Rules->bCompactReplication)
+	{
+		if (HasAnyFlags(RF_ClassDefaultObject))
+		{
+			ModifyClassRules([this](FExtendedAttributeSetRules& ClassRules)
+			{
+				BuildCompactAttributes(ClassRules);
+			});
+		}
+
+		CompactAttributeData.AttributeSetClass = GetClass();
+		RefreshCompactAttributeData();
+	}
+}
+
+void UExtendedAttributeSet::PostLoad()
+{
+	Super::PostLoad();
+
+	if (!HasAnyFlags(RF_ClassDefaultObject) || (MaxAttributesMap_DEPRECATED.IsEmpty() && MinMaxValuesMap_DEPRECATED.IsEmpty()))
+	{
+		return;
+	}
+
+	UE_LOG(LogAbilitySystem, Warning, TEXT("%s uses deprecated MaxAttributesMap or MinMaxValuesMap, ")
+	       TEXT("call SetMaxAttribute and SetAttributeValueRange from a native constructor instead."), *GetClass()->GetName());
+
+	for (const TTuple<FGameplayAttribute, FExtendedMaxAttributeRules>& Elem : MaxAttributesMap_DEPRECATED)
+	{
+		SetMaxAttribute(Elem.Key, Elem.Value.MaxAttribute, Elem.Value.bProportional);
+	}
+
+	ModifyClassRules([this](FExtendedAttributeSetRules& ClassRules)
+	{
+		ClassRules.ValueRanges.Append(MinMaxValuesMap_DEPRECATED);
+	});
+
+	MaxAttributesMap_DEPRECATED.Empty();
+	MinMaxValuesMap_DEPRECATED.Empty();
+
+	// the class may not have had its own rules before
+	Rules = FindRulesForClass(GetClass());
+}
+
+void UExtendedAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	Params.RepNotifyCondition = REPNOTIFY_Always;
+	Params.Condition = IsUsingCompactReplication() ? COND_None : COND_Never;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, CompactAttributeData, Params);
+}
+
+FDoRepLifetimeParams UExtendedAttributeSet::GetAttributeReplicationParams() const
+{
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	Params.RepNotifyCondition = REPNOTIFY_Always;
+	Params.Condition = IsUsingCompactReplication() ? COND_Never : COND_None;
+	return Params;
+}
+
+void UExtendedAttributeSet::ModifyClassRules(TFunctionRef<void(FExtendedAttributeSetRules& ClassRules)> Func)
+{
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		// instances use the rules built by their class default object
+		return;
+	}
+
+	FScopeLock Lock(&ExtendedAttributeSet::RulesByClassLock);
+	TUniquePtr<FExtendedAttributeSetRules>& ClassRules = ExtendedAttributeSet::RulesByClass.FindOrAdd(GetClass());
+	if (!ClassRules)
+	{
+		ClassRules = MakeUnique<FExtendedAttributeSetRules>();
+	}
+	Func(*ClassRules);
+}
+
+const FExtendedAttributeSetRules* UExtendedAttributeSet::FindRulesForClass(const UClass* AttributeSetClass)
+{
+	FScopeLock Lock(&ExtendedAttributeSet::RulesByClassLock);
+	for (const UClass* Class = AttributeSetClass; Class; Class = Class->GetSuperClass())
+	{
+		if (const TUniquePtr<FExtendedAttributeSetRules>* ClassRules = ExtendedAttributeSet::RulesByClass.Find(Class))
+		{
+			return ClassRules->Get();
+		}
+	}
+	return nullptr;
+}
+
 void UExtendedAttributeSet::SetMaxAttribute(const FGameplayAttribute& Attribute, const FGameplayAttribute& MaxAttribute, bool bProportional)
 {
-	FExtendedMaxAttributeRules& Rules = MaxAttributesMap.FindOrAdd(Attribute);
-	Rules.MaxAttribute = MaxAttribute;
-	Rules.bProportional = bProportional;
+	ModifyClassRules([&](FExtendedAttributeSetRules& ClassRules)
+	{
+		FExtendedMaxAttributeRules& MaxRules = ClassRules.MaxAttributes.FindOrAdd(Attribute);
+		if (MaxRules.MaxAttribute.IsValid())
+		{
+			ClassRules.DependentsByMaxAttribute.FindOrAdd(MaxRules.MaxAttribute).Remove(Attribute);
+		}
+		MaxRules.MaxAttribute = MaxAttribute;
+		MaxRules.bProportional = bProportional;
+		ClassRules.DependentsByMaxAttribute.FindOrAdd(MaxAttribute).AddUnique(Attribute);
+	});
 }
 
 void UExtendedAttributeSet::SetAttributeValueRange(const FGameplayAttribute& Attribute, float Min, float Max)
 {
-	MinMaxValuesMap.Emplace(Attribute, FFloatRange(Min, Max));
+	ModifyClassRules([&](FExtendedAttributeSetRules& ClassRules)
+	{
+		ClassRules.ValueRanges.Emplace(Attribute, FFloatRange(Min, Max));
+	});
+}
+
+void UExtendedAttributeSet::SetUseCompactReplication(bool bEnabled)
+{
+	ModifyClassRules([bEnabled](FExtendedAttributeSetRules& ClassRules)
+	{
+		ClassRules.bCompactReplication = bEnabled;
+	});
+}
+
+void UExtendedAttributeSet::SetAttributeQuantization(const FGameplayAttribute& Attribute, float Step)
+{
+	ModifyClassRules([&](FExtendedAttributeSetRules& ClassRules)
+	{
+		ClassRules.QuantizationSteps.Emplace(Attribute, FMath::Max(Step, 0.f));
+	});
+}
+
+bool UExtendedAttributeSet::IsUsingCompactReplication() const
+{
+	return Rules && Rules->bCompactReplication;
+}
+
+void UExtendedAttributeSet::BuildCompactAttributes(FExtendedAttributeSetRules& ClassRules) const
+{
+	ClassRules.CompactAttributes.Reset();
+	ClassRules.CompactQuantizationSteps.Reset();
+	ClassRules.CompactDefaultValues.Reset();
+
+	for (TFieldIterator<FProperty> It(GetClass(), EFieldIteratorFlags::IncludeSuper); It; ++It)
+	{
+		FProperty* Property = *It;
+		if (!Property->HasAnyPropertyFlags(CPF_Net) || !FGameplayAttribute::IsGameplayAttributeDataProperty(Property))
+		{
+			continue;
+		}
+
+		if (!ensureMsgf(ClassRules.CompactAttributes.Num() < FExtendedAttributeSetRules::MaxCompactAttributes,
+		                TEXT("%s has too many attributes for compact replication, %s will not replicate"),
+		                *GetClass()->GetName(), *Property->GetName()))
+		{
+			break;
+		}
+
+		const FGameplayAttribute Attribute(Property);
+		ClassRules.CompactAttributes.Add(Attribute);
+		ClassRules.CompactQuantizationSteps.Add(ClassRules.QuantizationSteps.FindRef(Attribute));
+		ClassRules.CompactDefaultValues.Add(Attribute.GetGameplayAttributeData(const_cast<ThisClass*>(this))->GetBaseValue());
+	}
+}
+
+void UExtendedAttributeSet::RefreshCompactAttributeData()
+{
+	if (!IsUsingCompactReplication())
+	{
+		return;
+	}
+
+	const int32 Num = Rules->CompactAttributes.Num();
+	CompactAttributeData.BaseValues.SetNum(Num);
+	CompactAttributeData.CurrentValues.SetNum(Num);
+
+	bool bChanged = false;
+	for (int32 Idx = 0; Idx < Num; ++Idx)
+	{
+		bChanged |= CopyToCompactAttributeData(Idx);
+	}
+
+	if (bChanged)
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, CompactAttributeData, this);
+		NotifyAttributeReplicationDirtied();
+	}
+}
+
+void UExtendedAttributeSet::MarkAttributeDirty(const FGameplayAttribute& Attribute)
+{
+	const FProperty* Property = Attribute.GetUProperty();
+	if (!Property || !Property->HasAnyPropertyFlags(CPF_Net) || !Property->GetOwnerClass() || !IsA(Property->GetOwnerClass()))
+	{
+		return;
+	}
+
+#if WITH_PUSH_MODEL
+	MARK_PROPERTY_DIRTY(this, Property);
+#endif
+
+	// in compact mode only changes that survive quantization are sent, see UpdateCompactAttribute
+	if (!IsUsingCompactReplication())
+	{
+		NotifyAttributeReplicationDirtied();
+	}
+}
+
+void UExtendedAttributeSet::NotifyAttributeReplicationDirtied() const
+{
+	if (UExtendedAbilitySystemComponent* ExtendedAbilitySystem = Cast<UExtendedAbilitySystemComponent>(GetOwningAbilitySystemComponent()))
+	{
+		ExtendedAbilitySystem->OnAttributeReplicationDirtiedEvent.Broadcast();
+	}
+}
+
+void UExtendedAttributeSet::UpdateCompactAttribute(const FGameplayAttribute& Attribute)
+{
+	if (!IsUsingCompactReplication())
+	{
+		return;
+	}
+
+	// clients receive compact data from the server, and only predict attribute values locally
+	const AActor* OwningActor = GetOwningActor();
+	if (!OwningActor || !OwningActor->HasAuthority())
+	{
+		return;
+	}
+
+	const int32 Idx = Rules->CompactAttributes.IndexOfByKey(Attribute);
+	if (Idx != INDEX_NONE && CopyToCompactAttributeData(Idx))
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, CompactAttributeData, this);
+		NotifyAttributeReplicationDirtied();
+	}
+}
+
+bool UExtendedAttributeSet::CopyToCompactAttributeData(int32 Index)
+{
+	const FGameplayAttributeData* AttributeData = Rules->CompactAttributes[Index].GetGameplayAttributeData(this);
+	const float Step = Rules->CompactQuantizationSteps[Index];
+
+	float& BaseValue = CompactAttributeData.BaseValues[Index];
+	float& CurrentValue = CompactAttributeData.CurrentValues[Index];
+	const bool bChanged = !ExtendedAttributeSet::IsQuantizedEqual(BaseValue, AttributeData->GetBaseValue(), Step) ||
+		!ExtendedAttributeSet::IsQuantizedEqual(CurrentValue, AttributeData->GetCurrentValue(), Step);
+
+	BaseValue = AttributeData->GetBaseValue();
+	CurrentValue = AttributeData->GetCurrentValue();
+	return bChanged;
+}
+
+void UExtendedAttributeSet::OnRep_CompactAttributeData(const FExtendedCompactAttributeData& OldData)
+{
+	UAbilitySystemComponent* AbilitySystem = GetOwningAbilitySystemComponent();
+	if (!Rules || !AbilitySystem)
+	{
+		return;
+	}
+
+	const int32 Num = FMath::Min(Rules->CompactAttributes.Num(), CompactAttributeData.BaseValues.Num());
+	const int32 OldNum = FMath::Min(OldData.BaseValues.Num(), OldData.CurrentValues.Num());
+	for (int32 Idx = 0; Idx < Num; ++Idx)
+	{
+		// only apply attributes that changed, as if they had been replicated individually
+		if (Idx < OldNum &&
+			OldData.BaseValues[Idx] == CompactAttributeData.BaseValues[Idx] &&
+			OldData.CurrentValues[Idx] == CompactAttributeData.CurrentValues[Idx])
+		{
+			continue;
+		}
+
+		const FGameplayAttribute& Attribute = Rules->CompactAttributes[Idx];
+		FGameplayAttributeData* AttributeData = Attribute.GetGameplayAttributeData(this);
+
+		// apply the same way as individually replicated attributes, see GAMEPLAYATTRIBUTE_REPNOTIFY
+		const FGameplayAttributeData OldValue = *AttributeData;
+		AttributeData->SetBaseValue(CompactAttributeData.BaseValues[Idx]);
+		AttributeData->SetCurrentValue(CompactAttributeData.CurrentValues[Idx]);
+		AbilitySystem->SetBaseAttributeValueFromReplication(Attribute, *AttributeData, OldValue);
+	}
 }
 
 void UExtendedAttributeSet::PreAttributeBaseChange(const FGameplayAttribute& Attribute, float& NewValue) const
@@ -38,16 +469,34 @@ void UExtendedAttributeSet::PostAttributeChange(const FGameplayAttribute& Attrib
 	Super::PostAttributeChange(Attribute, OldValue, NewValue);
 
 	AdjustOrClampForMaxAttribute(Attribute, OldValue, NewValue);
+
+	MarkAttributeDirty(Attribute);
+	UpdateCompactAttribute(Attribute);
+}
+
+void UExtendedAttributeSet::PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const
+{
+	Super::PostAttributeBaseChange(Attribute, OldValue, NewValue);
+
+	// the base value can change without affecting the current value, e.g. while overridden
+	ThisClass* MutableThis = const_cast<ThisClass*>(this);
+	MutableThis->MarkAttributeDirty(Attribute);
+	MutableThis->UpdateCompactAttribute(Attribute);
 }
 
 void UExtendedAttributeSet::ClampAttribute(const FGameplayAttribute& Attribute, float& NewValue) const
 {
-	if (const FExtendedMaxAttributeRules* MaxAttributeRules = MaxAttributesMap.Find(Attribute))
+	if (!Rules)
+	{
+		return;
+	}
+
+	if (const FExtendedMaxAttributeRules* MaxAttributeRules = Rules->MaxAttributes.Find(Attribute))
 	{
 		NewValue = FMath::Clamp(NewValue, 0.f, MaxAttributeRules->MaxAttribute.GetNumericValue(this));
 	}
 
-	if (const FFloatRange* MinMaxValues = MinMaxValuesMap.Find(Attribute))
+	if (const FFloatRange* MinMaxValues = Rules->ValueRanges.Find(Attribute))
 	{
 		const float Min = MinMaxValues->HasLowerBound() ? MinMaxValues->GetLowerBoundValue() : FLT_MIN;
 		const float Max = MinMaxValues->HasUpperBound() ? MinMaxValues->GetUpperBoundValue() : FLT_MAX;
@@ -57,30 +506,126 @@ void UExtendedAttributeSet::ClampAttribute(const FGameplayAttribute& Attribute,
 
 void UExtendedAttributeSet::AdjustOrClampForMaxAttribute(const FGameplayAttribute& MaxAttribute, float OldMaxValue, float NewMaxValue)
 {
-	for (const TTuple<FGameplayAttribute, FExtendedMaxAttributeRules>& Elem : MaxAttributesMap)
+	const TArray<FGameplayAttribute>* Dependents = Rules ? Rules->DependentsByMaxAttribute.Find(MaxAttribute) : nullptr;
+	if (!Dependents)
+	{
+		return;
+	}
+
+	for (const FGameplayAttribute& Attribute : *Dependents)
 	{
-		if (Elem.Value.MaxAttribute == MaxAttribute)
+		const FExtendedMaxAttributeRules& MaxAttributeRules = Rules->MaxAttributes.FindChecked(Attribute);
+		if (MaxAttributeRules.bProportional)
 		{
-			const FGameplayAttribute& Attribute = Elem.Key;
-			if (Elem.Value.bProportional)
-			{
-				// keep proportional and clamp
-				UExtendedAbilitySystemStatics::AdjustProportionalAttribute(this, Attribute, OldMaxValue, NewMaxValue, false, true);
-			}
-			else
+			// keep proportional and clamp
+			UExtendedAbilitySystemStatics::AdjustProportionalAttribute(this, Attribute, OldMaxValue, NewMaxValue, false, true);
+		}
+		else
+		{
+			// just clamp
+			if (UAbilitySystemComponent* AbilitySystem = GetOwningAbilitySystemComponent())
 			{
-				// just clamp
-				if (UAbilitySystemComponent* AbilitySystem = GetOwningAbilitySystemComponent())
-				{
-					const float CurrentValue = UExtendedAbilitySystemStatics::GetNumericAttributeBase(this, Attribute);
-					const float NewValue = FMath::Min(CurrentValue, NewMaxValue);
-					AbilitySystem->SetNumericAttributeBase(Attribute, NewValue);
-				}
+				const float CurrentValue = UExtendedAbilitySystemStatics::GetNumericAttributeBase(this, Attribute);
+				const float NewValue = FMath::Min(CurrentValue, NewMaxValue);
+				AbilitySystem->SetNumericAttributeBase(Attribute, NewValue);
 			}
 		}
 	}
 }
 
+int32 UExtendedAttributeSet::InitAttributeValues(const TMap<FGameplayAttribute, float>& Values)
+{
+	TArray<FGameplayAttribute, TInlineAllocator<16>> InitializedAttributes;
+
+	// write all values first, since clamping may depend on other attributes in the set
+	for (const TTuple<FGameplayAttribute, float>& Elem : Values)
+	{
+		const FGameplayAttribute& Attribute = Elem.Key;
+		const UClass* AttributeSetClass = Attribute.GetAttributeSetClass();
+		if (!AttributeSetClass || !IsA(AttributeSetClass))
+		{
+			continue;
+		}
+
+		if (FGameplayAttributeData* AttributeData = Attribute.GetGameplayAttributeData(this))
+		{
+			InitAttribute(*AttributeData, Elem.Value);
+			InitializedAttributes.Add(Attribute);
+		}
+		else if (const FFloatProperty* FloatProperty = CastField<FFloatProperty>(Attribute.GetUProperty()))
+		{
+			FloatProperty->SetPropertyValue_InContainer(this, Elem.Value);
+			InitializedAttributes.Add(Attribute);
+		}
+	}
+
+	if (InitializedAttributes.IsEmpty())
+	{
+		return 0;
+	}
+
+	for (const FGameplayAttribute& Attribute : InitializedAttributes)
+	{
+		if (FGameplayAttributeData* AttributeData = Attribute.GetGameplayAttributeData(this))
+		{
+			float BaseValue = AttributeData->GetBaseValue();
+			ClampAttribute(Attribute, BaseValue);
+			InitAttribute(*AttributeData, BaseValue);
+		}
+		MarkAttributeDirty(Attribute);
+	}
+
+	RefreshCompactAttributeData();
+
+	if (AActor* OwningActor = GetOwningActor())
+	{
+		OwningActor->ForceNetUpdate();
+	}
+
+	OnAttributesInitializedEvent.Broadcast(this);
+
+	return InitializedAttributes.Num();
+}
+
+int32 UExtendedAttributeSet::InitFromDataTableRow(const FDataTableRowHandle& RowHandle)
+{
+	static const FString ContextString(TEXT("UExtendedAttributeSet::InitFromDataTableRow"));
+	if (const FExtendedAttributeSetInitRow* Row = RowHandle.GetRow<FExtendedAttributeSetInitRow>(ContextString))
+	{
+		return InitAttributeValues(Row->Values);
+	}
+	return 0;
+}
+
+int32 UExtendedAttributeSet::InitFromCurveTable(const UCurveTable* CurveTable, FName RowPrefix, float Level)
+{
+	if (!CurveTable)
+	{
+		return 0;
+	}
+
+	static const FString ContextString(TEXT("UExtendedAttributeSet::InitFromCurveTable"));
+	const FString RowPrefixString = RowPrefix.IsNone() ? FString() : RowPrefix.ToString() + TEXT(".");
+
+	TMap<FGameplayAttribute, float> Values;
+	for (TFieldIterator<FProperty> It(GetClass(), EFieldIteratorFlags::IncludeSuper); It; ++It)
+	{
+		FProperty* Property = *It;
+		if (!FGameplayAttribute::IsGameplayAttributeDataProperty(Property) && !CastField<FFloatProperty>(Property))
+		{
+			continue;
+		}
+
+		const FName RowName(RowPrefixString + Property->GetName());
+		if (const FRealCurve* Curve = CurveTable->FindCurve(RowName, ContextString, false))
+		{
+			Values.Add(FGameplayAttribute(Property), Curve->Eval(Level));
+		}
+	}
+
+	return InitAttributeValues(Values);
+}
+
 void UExtendedAttributeSet::InitAttribute(FGameplayAttributeData& AttributeData, float Value)
 {
 	AttributeData.SetBaseValue(Value);
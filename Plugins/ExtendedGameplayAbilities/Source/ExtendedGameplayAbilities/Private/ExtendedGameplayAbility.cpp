@@ -277,15 +277,19 @@ FGameplayEffectSpecSet UExtendedGameplayAbility::MakeEffectSpecSet(const FGamepl
 		OverrideGameplayLevel = GetAbilityLevel();
 	}
 
-	const UAbilitySystemComponent* AbilitySystem = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwningActorFromActorInfo());
-	if (!AbilitySystem)
+	if (!CurrentActorInfo || !CurrentActorInfo->AbilitySystemComponent.IsValid())
 	{
 		return Result;
 	}
 
+	Result.EffectSpecs.Reserve(EffectSet.Effects.Num());
+
+	// all specs share one context, MakeOutgoingGameplayEffectSpec would create a context per spec
+	Result.Context = MakeEffectContext(CurrentSpecHandle, CurrentActorInfo);
+
 	for (const TSubclassOf<UGameplayEffect>& EffectClass : EffectSet.Effects)
 	{
-		FGameplayEffectSpecHandle NewEffectSpec = MakeOutgoingGameplayEffectSpec(EffectClass, OverrideGameplayLevel);
+		FGameplayEffectSpecHandle NewEffectSpec = MakeOutgoingGameplayEffectSpecWithContext(EffectClass, OverrideGameplayLevel, Result.Context);
 		if (NewEffectSpec.IsValid())
 		{
 			for (const auto& Item : EffectSet.SetByCallerMagnitudes)
@@ -301,6 +305,31 @@ FGameplayEffectSpecSet UExtendedGameplayAbility::MakeEffectSpecSet(const FGamepl
 	return Result;
 }
 
+FGameplayEffectSpecHandle UExtendedGameplayAbility::MakeOutgoingGameplayEffectSpecWithContext(TSubclassOf<UGameplayEffect> GameplayEffectClass, float Level,
+                                                                                          const FGameplayEffectContextHandle& Context) const
+{
+	check(CurrentActorInfo);
+	UAbilitySystemComponent* AbilitySystem = CurrentActorInfo->AbilitySystemComponent.Get();
+	if (!AbilitySystem)
+	{
+		return FGameplayEffectSpecHandle();
+	}
+
+	FGameplayEffectSpecHandle NewHandle = AbilitySystem->MakeOutgoingSpec(GameplayEffectClass, Level, Context);
+	if (NewHandle.IsValid())
+	{
+		FGameplayAbilitySpec* AbilitySpec = AbilitySystem->FindAbilitySpecFromHandle(CurrentSpecHandle);
+		ApplyAbilityTagsToGameplayEffectSpec(*NewHandle.Data.Get(), AbilitySpec);
+
+		// copy over set by caller magnitudes
+		if (AbilitySpec)
+		{
+			NewHandle.Data->SetByCallerTagMagnitudes = AbilitySpec->SetByCallerTagMagnitudes;
+		}
+	}
+	return NewHandle;
+}
+
 FGameplayEffectSpecSet UExtendedGameplayAbility::MakeEffectSpecSetByTag(FGameplayTag Tag, int32 OverrideGameplayLevel)
 {
 	if (EffectSetMap.Contains(Tag))
@@ -0,0 +1,78 @@
+﻿// Copyright Bohdon Sayre, All Rights Reserved.
+
+
+#include "GameStateComponentSubsystem.h"
+
+#include "Components/ActorComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+
+
+UGameStateComponentSubsystem* UGameStateComponentSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	return World ? World->GetSubsystem<UGameStateComponentSubsystem>() : nullptr;
+}
+
+void UGameStateComponentSubsystem::RegisterComponent(UActorComponent* Component)
+{
+	if (!Component)
+	{
+		return;
+	}
+
+	for (const UClass* Class = Component->GetClass(); Class && Class != UActorComponent::StaticClass(); Class = Class->GetSuperClass())
+	{
+		ComponentsByClass.Add(Class, Component);
+	}
+}
+
+void UGameStateComponentSubsystem::UnregisterComponent(UActorComponent* Component)
+{
+	if (!Component)
+	{
+		return;
+	}
+
+	for (const UClass* Class = Component->GetClass(); Class && Class != UActorComponent::StaticClass(); Class = Class->GetSuperClass())
+	{
+		const TWeakObjectPtr<UActorComponent>* Registered = ComponentsByClass.Find(Class);
+		if (Registered && (!Registered->IsValid() || Registered->Get() == Component))
+		{
+			ComponentsByClass.Remove(Class);
+		}
+	}
+}
+
+UActorComponent* UGameStateComponentSubsystem::FindComponent(const UClass* ComponentClass) const
+{
+	if (!ComponentClass)
+	{
+		return nullptr;
+	}
+
+	if (const TWeakObjectPtr<UActorComponent>* Component = ComponentsByClass.Find(ComponentClass))
+	{
+		if (UActorComponent* ComponentPtr = Component->Get())
+		{
+			return ComponentPtr;
+		}
+	}
+
+	// fall back to searching the game state, for components that don't register themselves
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	UActorComponent* FoundComponent = GameState ? GameState->FindComponentByClass(ComponentClass) : nullptr;
+	if (FoundComponent)
+	{
+		ComponentsByClass.Add(ComponentClass, FoundComponent);
+	}
+	return FoundComponent;
+}
+
+void UGameStateComponentSubsystem::Deinitialize()
+{
+	ComponentsByClass.Reset();
+
+	Super::Deinitialize();
+}
@@ -19,3 +19,28 @@ bool FGameplayEffectSpecSet::IsEmpty() const
 {
 	return EffectSpecs.IsEmpty();
 }
+
+void FGameplayEffectSpecSet::ForEachContext(TFunctionRef<void(FGameplayEffectContextHandle& EffectContext)> Func) const
+{
+	// handles are copied, but still reference the same context data
+	FGameplayEffectContextHandle SharedContext = Context;
+	if (SharedContext.IsValid())
+	{
+		Func(SharedContext);
+	}
+
+	// specs may have been added to the set with their own context
+	for (const FGameplayEffectSpecHandle& SpecHandle : EffectSpecs)
+	{
+		if (!SpecHandle.IsValid())
+		{
+			continue;
+		}
+
+		FGameplayEffectContextHandle SpecContext = SpecHandle.Data->GetContext();
+		if (SpecContext.IsValid() && SpecContext.Get() != SharedContext.Get())
+		{
+			Func(SpecContext);
+		}
+	}
+}
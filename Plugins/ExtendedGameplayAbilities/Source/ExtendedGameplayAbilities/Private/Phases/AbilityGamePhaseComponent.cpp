@@ -4,6 +4,7 @@
 #include "Phases/AbilityGamePhaseComponent.h"
 
 #include "AbilitySystemComponent.h"
+#include "GameStateComponentSubsystem.h"
 #include "NativeGameplayTags.h"
 #include "Phases/GamePhaseAbility.h"
 
@@ -49,6 +50,26 @@ void UAbilityGamePhaseComponent::StartPhase(TSubclassOf<UGamePhaseAbility> Phase
 	}
 }
 
+void UAbilityGamePhaseComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UGameStateComponentSubsystem* ComponentSubsystem = UGameStateComponentSubsystem::Get(this))
+	{
+		ComponentSubsystem->RegisterComponent(this);
+	}
+}
+
+void UAbilityGamePhaseComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGameStateComponentSubsystem* ComponentSubsystem = UGameStateComponentSubsystem::Get(this))
+	{
+		ComponentSubsystem->UnregisterComponent(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 bool UAbilityGamePhaseComponent::IsPhaseActive(FGameplayTag PhaseTag)
 {
 	for (auto& Elem : ActivePhases)
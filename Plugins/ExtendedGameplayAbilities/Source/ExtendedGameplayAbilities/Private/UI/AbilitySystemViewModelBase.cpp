@@ -10,6 +10,17 @@
 
 #define LOCTEXT_NAMESPACE "ExtendedGameplayAbilities"
 
+void UAbilitySystemViewModelBase::BeginDestroy()
+{
+	if (DeferredFlushTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DeferredFlushTickerHandle);
+		DeferredFlushTickerHandle.Reset();
+	}
+
+	Super::BeginDestroy();
+}
+
 void UAbilitySystemViewModelBase::SetAbilitySystem(UAbilitySystemComponent* NewAbilitySystem)
 {
 #if !NO_LOGGING
@@ -44,4 +55,113 @@ void UAbilitySystemViewModelBase::PostSystemChange()
 	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilitySystem);
 }
 
+void UAbilitySystemViewModelBase::SetUpdatesSuspended(bool bNewUpdatesSuspended)
+{
+	if (bUpdatesSuspended == bNewUpdatesSuspended)
+	{
+		return;
+	}
+
+	if (bNewUpdatesSuspended)
+	{
+		// unbind everything, and leave it unbound until resumed
+		PreSystemChange();
+		bUpdatesSuspended = true;
+	}
+	else
+	{
+		// rebind and broadcast all fields, since anything may have changed while suspended
+		bUpdatesSuspended = false;
+		PostSystemChange();
+	}
+
+	OnUpdatesSuspendedChanged();
+}
+
+void UAbilitySystemViewModelBase::OnUpdatesSuspendedChanged()
+{
+}
+
+void UAbilitySystemViewModelBase::SetDeferFieldNotifications(bool bNewDeferFieldNotifications)
+{
+	if (bDeferFieldNotifications != bNewDeferFieldNotifications)
+	{
+		bDeferFieldNotifications = bNewDeferFieldNotifications;
+		if (!bDeferFieldNotifications)
+		{
+			FlushDeferredFieldNotifications();
+		}
+	}
+}
+
+void UAbilitySystemViewModelBase::SetDeferredNotifyInterval(float NewDeferredNotifyInterval)
+{
+	DeferredNotifyInterval = FMath::Max(NewDeferredNotifyInterval, 0.f);
+}
+
+void UAbilitySystemViewModelBase::BroadcastOrDeferFieldValueChanged(UE::FieldNotification::FFieldId FieldId)
+{
+	if (!bDeferFieldNotifications)
+	{
+		BroadcastFieldValueChanged(FieldId);
+		return;
+	}
+
+	const int32 FieldIndex = FieldId.GetIndex();
+	if (!FieldId.IsValid() || FieldIndex < 0)
+	{
+		return;
+	}
+
+	if (DeferredFieldBits.Num() <= FieldIndex)
+	{
+		DeferredFieldBits.Add(false, FieldIndex + 1 - DeferredFieldBits.Num());
+	}
+	if (DeferredFieldBits[FieldIndex])
+	{
+		// already pending
+		return;
+	}
+	DeferredFieldBits[FieldIndex] = true;
+	DeferredFieldIds.Add(FieldId);
+
+	if (!DeferredFlushTickerHandle.IsValid())
+	{
+		DeferredFlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UAbilitySystemViewModelBase::HandleDeferredFlushTicker), DeferredNotifyInterval);
+	}
+}
+
+void UAbilitySystemViewModelBase::FlushDeferredFieldNotifications()
+{
+	if (DeferredFlushTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DeferredFlushTickerHandle);
+		DeferredFlushTickerHandle.Reset();
+	}
+
+	if (DeferredFieldIds.IsEmpty())
+	{
+		return;
+	}
+
+	// swap out the pending fields first, since broadcasts may defer new changes
+	TArray<UE::FieldNotification::FFieldId> FieldIds = MoveTemp(DeferredFieldIds);
+	DeferredFieldIds.Reset();
+	DeferredFieldBits.SetRange(0, DeferredFieldBits.Num(), false);
+
+	for (const UE::FieldNotification::FFieldId& FieldId : FieldIds)
+	{
+		BroadcastFieldValueChanged(FieldId);
+	}
+}
+
+bool UAbilitySystemViewModelBase::HandleDeferredFlushTicker(float DeltaTime)
+{
+	// the ticker is removed after returning false, so just forget the handle
+	DeferredFlushTickerHandle.Reset();
+	FlushDeferredFieldNotifications();
+	return false;
+}
+
 #undef LOCTEXT_NAMESPACE
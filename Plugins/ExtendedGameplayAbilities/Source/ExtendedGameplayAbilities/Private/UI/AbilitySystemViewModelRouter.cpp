@@ -0,0 +1,507 @@
+﻿// Copyright Bohdon Sayre, All Rights Reserved.
+
+
+#include "UI/AbilitySystemViewModelRouter.h"
+
+#include "AbilitySystemComponent.h"
+#include "ExtendedAbilitySystemComponent.h"
+#include "UI/VM_GameplayAbility.h"
+
+
+namespace AbilitySystemViewModelRouter
+{
+	/** Routers by ability system. Entries are removed when the router is destroyed. */
+	TMap<TObjectKey<UAbilitySystemComponent>, TWeakObjectPtr<UAbilitySystemViewModelRouter>> Routers;
+}
+
+
+UAbilitySystemViewModelRouter* UAbilitySystemViewModelRouter::GetOrCreate(UAbilitySystemComponent* InAbilitySystem)
+{
+	if (!InAbilitySystem)
+	{
+		return nullptr;
+	}
+
+	TWeakObjectPtr<UAbilitySystemViewModelRouter>& RouterPtr = AbilitySystemViewModelRouter::Routers.FindOrAdd(InAbilitySystem);
+	if (UAbilitySystemViewModelRouter* ExistingRouter = RouterPtr.Get())
+	{
+		return ExistingRouter;
+	}
+
+	UAbilitySystemViewModelRouter* NewRouter = NewObject<UAbilitySystemViewModelRouter>(InAbilitySystem, NAME_None, RF_Transient);
+	NewRouter->BindToAbilitySystem(InAbilitySystem);
+	RouterPtr = NewRouter;
+	return NewRouter;
+}
+
+void UAbilitySystemViewModelRouter::BeginDestroy()
+{
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		UnbindFromAbilitySystem();
+	}
+
+	Super::BeginDestroy();
+}
+
+void UAbilitySystemViewModelRouter::BindToAbilitySystem(UAbilitySystemComponent* InAbilitySystem)
+{
+	AbilitySystem = InAbilitySystem;
+	AbilitySystemKey = InAbilitySystem;
+
+	InAbilitySystem->AbilityActivatedCallbacks.AddUObject(this, &UAbilitySystemViewModelRouter::OnAbilityActivated);
+	InAbilitySystem->OnAbilityEnded.AddUObject(this, &UAbilitySystemViewModelRouter::OnAbilityEnded);
+	InAbilitySystem->OnActiveGameplayEffectAddedDelegateToSelf.AddUObject(this, &UAbilitySystemViewModelRouter::OnActiveGameplayEffectAdded);
+	InAbilitySystem->OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &UAbilitySystemViewModelRouter::OnAnyGameplayEffectRemoved);
+	InAbilitySystem->RegisterGenericGameplayTagEvent().AddUObject(this, &UAbilitySystemViewModelRouter::OnAnyTagChanged);
+
+	if (UExtendedAbilitySystemComponent* ExtendedAbilitySystem = Cast<UExtendedAbilitySystemComponent>(InAbilitySystem))
+	{
+		ExtendedAbilitySystem->OnAbilityTagRelationshipMappingChangedEvent.AddUObject(
+			this, &UAbilitySystemViewModelRouter::OnAbilityTagRelationshipMappingChanged);
+		ExtendedAbilitySystem->OnAbilityBlockTagsChangedEvent.AddUObject(this, &UAbilitySystemViewModelRouter::OnAbilityBlockTagsChanged);
+		bHasAbilityBlockTagEvents = true;
+	}
+}
+
+void UAbilitySystemViewModelRouter::UnbindFromAbilitySystem()
+{
+	const TWeakObjectPtr<UAbilitySystemViewModelRouter>* RouterPtr = AbilitySystemViewModelRouter::Routers.Find(AbilitySystemKey);
+	if (RouterPtr && (!RouterPtr->IsValid() || RouterPtr->Get() == this))
+	{
+		AbilitySystemViewModelRouter::Routers.Remove(AbilitySystemKey);
+	}
+
+	if (UAbilitySystemComponent* ASC = AbilitySystem.Get())
+	{
+		ASC->AbilityActivatedCallbacks.RemoveAll(this);
+		ASC->OnAbilityEnded.RemoveAll(this);
+		ASC->OnActiveGameplayEffectAddedDelegateToSelf.RemoveAll(this);
+		ASC->OnAnyGameplayEffectRemovedDelegate().RemoveAll(this);
+		ASC->RegisterGenericGameplayTagEvent().RemoveAll(this);
+
+		if (UExtendedAbilitySystemComponent* ExtendedAbilitySystem = Cast<UExtendedAbilitySystemComponent>(ASC))
+		{
+			ExtendedAbilitySystem->OnAbilityTagRelationshipMappingChangedEvent.RemoveAll(this);
+			ExtendedAbilitySystem->OnAbilityBlockTagsChangedEvent.RemoveAll(this);
+		}
+
+		for (const auto& Elem : CooldownTagEventHandles)
+		{
+			ASC->UnregisterGameplayTagEvent(Elem.Value, Elem.Key);
+		}
+
+		for (const auto& Elem : ListenersByCostAttribute)
+		{
+			ASC->GetGameplayAttributeValueChangeDelegate(Elem.Key).RemoveAll(this);
+		}
+	}
+
+	AbilitySystem.Reset();
+	AbilitySystemKey = TObjectKey<UAbilitySystemComponent>();
+	Registrations.Reset();
+	ListenersByAbilityClass.Reset();
+	ListenersBySpecHandle.Reset();
+	ListenersByCooldownTag.Reset();
+	ListenersByActivationTag.Reset();
+	ListenersByCostAttribute.Reset();
+	ListenersByCooldownEffect.Reset();
+	CooldownTagEventHandles.Reset();
+	AllTagListeners.Reset();
+	ListenersByAbilityTag.Reset();
+	bHasAbilityBlockTagEvents = false;
+}
+
+void UAbilitySystemViewModelRouter::RegisterAbilityViewModel(UVM_GameplayAbility* ViewModel)
+{
+	if (!ViewModel || !AbilitySystem.IsValid())
+	{
+		return;
+	}
+
+	UnregisterAbilityViewModel(ViewModel);
+
+	FAbilityRegistration& Registration = Registrations.Add(ViewModel);
+	Registration.AbilitySpecHandle = ViewModel->GetAbilitySpecHandle();
+	Registration.AbilityClass = ViewModel->GetAbilityClass().Get();
+	Registration.CooldownTags = ViewModel->CooldownTags;
+	Registration.bListensToAllTags = !ViewModel->GetActivationRelevantTags(Registration.ActivationTags);
+	Registration.CostAttributes = ViewModel->GetCostAttributes();
+	Registration.CooldownEffectHandle = ViewModel->GetActiveCooldownEffect();
+	if (const UGameplayAbility* AbilityCDO = ViewModel->GetAbilityCDO())
+	{
+		Registration.AbilityTags = AbilityCDO->GetAssetTags();
+		Registration.bIsBlocked = AbilitySystem->AreAbilityTagsBlocked(Registration.AbilityTags);
+	}
+
+	ListenersByAbilityClass.FindOrAdd(Registration.AbilityClass).Add(ViewModel);
+	ListenersBySpecHandle.FindOrAdd(Registration.AbilitySpecHandle).Add(ViewModel);
+
+	if (Registration.CooldownEffectHandle.IsValid())
+	{
+		ListenersByCooldownEffect.FindOrAdd(Registration.CooldownEffectHandle).Add(ViewModel);
+	}
+
+	if (Registration.bListensToAllTags)
+	{
+		AllTagListeners.Add(ViewModel);
+	}
+
+	for (const FGameplayTag& AbilityTag : Registration.AbilityTags.GetGameplayTagParents())
+	{
+		ListenersByAbilityTag.FindOrAdd(AbilityTag).Add(ViewModel);
+	}
+
+	for (const FGameplayTag& ActivationTag : Registration.ActivationTags)
+	{
+		ListenersByActivationTag.FindOrAdd(ActivationTag).Add(ViewModel);
+	}
+
+	for (const FGameplayTag& CooldownTag : Registration.CooldownTags)
+	{
+		AddCooldownTagListener(CooldownTag, ViewModel);
+	}
+
+	for (const FGameplayAttribute& Attribute : Registration.CostAttributes)
+	{
+		AddCostAttributeListener(Attribute, ViewModel);
+	}
+}
+
+void UAbilitySystemViewModelRouter::UnregisterAbilityViewModel(UVM_GameplayAbility* ViewModel)
+{
+	FAbilityRegistration Registration;
+	if (!Registrations.RemoveAndCopyValue(ViewModel, Registration))
+	{
+		return;
+	}
+
+	RemoveListener(ListenersByAbilityClass, Registration.AbilityClass, ViewModel);
+	RemoveListener(ListenersBySpecHandle, Registration.AbilitySpecHandle, ViewModel);
+	RemoveListener(ListenersByCooldownEffect, Registration.CooldownEffectHandle, ViewModel);
+
+	if (Registration.bListensToAllTags)
+	{
+		AllTagListeners.RemoveSingleSwap(ViewModel);
+	}
+
+	for (const FGameplayTag& AbilityTag : Registration.AbilityTags.GetGameplayTagParents())
+	{
+		RemoveListener(ListenersByAbilityTag, AbilityTag, ViewModel);
+	}
+
+	for (const FGameplayTag& ActivationTag : Registration.ActivationTags)
+	{
+		RemoveListener(ListenersByActivationTag, ActivationTag, ViewModel);
+	}
+
+	for (const FGameplayTag& CooldownTag : Registration.CooldownTags)
+	{
+		RemoveCooldownTagListener(CooldownTag, ViewModel);
+	}
+
+	for (const FGameplayAttribute& Attribute : Registration.CostAttributes)
+	{
+		RemoveCostAttributeListener(Attribute, ViewModel);
+	}
+}
+
+void UAbilitySystemViewModelRouter::UpdateCooldownEffect(UVM_GameplayAbility* ViewModel, FActiveGameplayEffectHandle CooldownEffectHandle)
+{
+	FAbilityRegistration* Registration = Registrations.Find(ViewModel);
+	if (!Registration || Registration->CooldownEffectHandle == CooldownEffectHandle)
+	{
+		return;
+	}
+
+	RemoveListener(ListenersByCooldownEffect, Registration->CooldownEffectHandle, ViewModel);
+	Registration->CooldownEffectHandle = CooldownEffectHandle;
+	if (CooldownEffectHandle.IsValid())
+	{
+		ListenersByCooldownEffect.FindOrAdd(CooldownEffectHandle).Add(ViewModel);
+	}
+}
+
+void UAbilitySystemViewModelRouter::AddCooldownTagListener(const FGameplayTag& CooldownTag, UVM_GameplayAbility* ViewModel)
+{
+	FListenerArray& Listeners = ListenersByCooldownTag.FindOrAdd(CooldownTag);
+	if (Listeners.IsEmpty())
+	{
+		// first listener for this tag, bind to the ability system
+		FOnGameplayEffectTagCountChanged& TagEvent = AbilitySystem->RegisterGameplayTagEvent(CooldownTag);
+		CooldownTagEventHandles.Add(CooldownTag, TagEvent.AddUObject(this, &UAbilitySystemViewModelRouter::OnCooldownTagChanged));
+	}
+	Listeners.Add(ViewModel);
+}
+
+void UAbilitySystemViewModelRouter::RemoveCooldownTagListener(const FGameplayTag& CooldownTag, UVM_GameplayAbility* ViewModel)
+{
+	FListenerArray* Listeners = ListenersByCooldownTag.Find(CooldownTag);
+	if (!Listeners)
+	{
+		return;
+	}
+
+	Listeners->RemoveSingleSwap(ViewModel);
+	if (Listeners->IsEmpty())
+	{
+		ListenersByCooldownTag.Remove(CooldownTag);
+
+		FDelegateHandle EventHandle;
+		UAbilitySystemComponent* ASC = AbilitySystem.Get();
+		if (CooldownTagEventHandles.RemoveAndCopyValue(CooldownTag, EventHandle) && ASC)
+		{
+			ASC->UnregisterGameplayTagEvent(EventHandle, CooldownTag);
+		}
+	}
+}
+
+void UAbilitySystemViewModelRouter::AddCostAttributeListener(const FGameplayAttribute& Attribute, UVM_GameplayAbility* ViewModel)
+{
+	FListenerArray& Listeners = ListenersByCostAttribute.FindOrAdd(Attribute);
+	if (Listeners.IsEmpty())
+	{
+		// first listener for this attribute, bind to the ability system
+		AbilitySystem->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(this, &UAbilitySystemViewModelRouter::OnCostAttributeChanged);
+	}
+	Listeners.Add(ViewModel);
+}
+
+void UAbilitySystemViewModelRouter::RemoveCostAttributeListener(const FGameplayAttribute& Attribute, UVM_GameplayAbility* ViewModel)
+{
+	FListenerArray* Listeners = ListenersByCostAttribute.Find(Attribute);
+	if (!Listeners)
+	{
+		return;
+	}
+
+	Listeners->RemoveSingleSwap(ViewModel);
+	if (Listeners->IsEmpty())
+	{
+		ListenersByCostAttribute.Remove(Attribute);
+		if (UAbilitySystemComponent* ASC = AbilitySystem.Get())
+		{
+			ASC->GetGameplayAttributeValueChangeDelegate(Attribute).RemoveAll(this);
+		}
+	}
+}
+
+template <typename KeyType>
+void UAbilitySystemViewModelRouter::RemoveListener(TMap<KeyType, FListenerArray>& ListenerMap, const KeyType& Key, UVM_GameplayAbility* ViewModel)
+{
+	if (FListenerArray* Listeners = ListenerMap.Find(Key))
+	{
+		Listeners->RemoveSingleSwap(ViewModel);
+		if (Listeners->IsEmpty())
+		{
+			ListenerMap.Remove(Key);
+		}
+	}
+}
+
+template <typename FuncType>
+void UAbilitySystemViewModelRouter::Dispatch(const FListenerArray* Listeners, FuncType&& Func) const
+{
+	if (!Listeners || Listeners->IsEmpty())
+	{
+		return;
+	}
+
+	// copy the listeners, since view models may be registered or unregistered in response to the event
+	const TArray<TWeakObjectPtr<UVM_GameplayAbility>, TInlineAllocator<8>> ListenersCopy(*Listeners);
+	for (const TWeakObjectPtr<UVM_GameplayAbility>& ListenerPtr : ListenersCopy)
+	{
+		UVM_GameplayAbility* ViewModel = ListenerPtr.Get();
+		if (ViewModel && Registrations.Contains(ViewModel))
+		{
+			Func(ViewModel);
+		}
+	}
+}
+
+void UAbilitySystemViewModelRouter::UpdateBlockedAbilities(TConstArrayView<TWeakObjectPtr<UVM_GameplayAbility>> ViewModels)
+{
+	UAbilitySystemComponent* ASC = AbilitySystem.Get();
+	if (!ASC)
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<UVM_GameplayAbility>, TInlineAllocator<8>> ChangedViewModels;
+	for (const TWeakObjectPtr<UVM_GameplayAbility>& ViewModelPtr : ViewModels)
+	{
+		FAbilityRegistration* Registration = Registrations.Find(ViewModelPtr.Get());
+		if (!Registration || Registration->AbilityTags.IsEmpty())
+		{
+			continue;
+		}
+
+		const bool bIsBlocked = ASC->AreAbilityTagsBlocked(Registration->AbilityTags);
+		if (bIsBlocked != Registration->bIsBlocked)
+		{
+			Registration->bIsBlocked = bIsBlocked;
+			ChangedViewModels.Add(ViewModelPtr);
+		}
+	}
+
+	for (const TWeakObjectPtr<UVM_GameplayAbility>& ViewModelPtr : ChangedViewModels)
+	{
+		if (UVM_GameplayAbility* ViewModel = ViewModelPtr.Get())
+		{
+			ViewModel->InvalidateCanActivate();
+		}
+	}
+}
+
+void UAbilitySystemViewModelRouter::UpdateAllBlockedAbilities()
+{
+	TArray<TWeakObjectPtr<UVM_GameplayAbility>, TInlineAllocator<8>> ViewModels;
+	ViewModels.Reserve(Registrations.Num());
+	for (const auto& Elem : Registrations)
+	{
+		ViewModels.Add(Elem.Key.ResolveObjectPtr());
+	}
+
+	UpdateBlockedAbilities(ViewModels);
+}
+
+void UAbilitySystemViewModelRouter::OnAbilityActivated(UGameplayAbility* GameplayAbility)
+{
+	if (GameplayAbility)
+	{
+		Dispatch(ListenersByAbilityClass.Find(GameplayAbility->GetClass()), [GameplayAbility](UVM_GameplayAbility* ViewModel)
+		{
+			ViewModel->OnAnyAbilityActivated(GameplayAbility);
+		});
+	}
+
+	// the activated ability may have blocked other abilities
+	if (!bHasAbilityBlockTagEvents)
+	{
+		UpdateAllBlockedAbilities();
+	}
+}
+
+void UAbilitySystemViewModelRouter::OnAbilityEnded(const FAbilityEndedData& AbilityEndedData)
+{
+	Dispatch(ListenersBySpecHandle.Find(AbilityEndedData.AbilitySpecHandle), [&AbilityEndedData](UVM_GameplayAbility* ViewModel)
+	{
+		ViewModel->OnAnyAbilityEnded(AbilityEndedData);
+	});
+
+	// the ended ability may have unblocked other abilities
+	if (!bHasAbilityBlockTagEvents)
+	{
+		UpdateAllBlockedAbilities();
+	}
+}
+
+void UAbilitySystemViewModelRouter::OnActiveGameplayEffectAdded(UAbilitySystemComponent* AbilitySystemComponent,
+                                                               const FGameplayEffectSpec& GameplayEffectSpec,
+                                                               FActiveGameplayEffectHandle ActiveGameplayEffectHandle)
+{
+	if (ListenersByCooldownTag.IsEmpty())
+	{
+		return;
+	}
+
+	FGameplayTagContainer GrantedTags;
+	GameplayEffectSpec.GetAllGrantedTags(GrantedTags);
+	if (GrantedTags.IsEmpty())
+	{
+		return;
+	}
+
+	// gather view models with a cooldown tag matching any granted tag or its parents, notifying each only once
+	TArray<TWeakObjectPtr<UVM_GameplayAbility>, TInlineAllocator<8>> MatchingListeners;
+	for (const FGameplayTag& GrantedTag : GrantedTags.GetGameplayTagParents())
+	{
+		if (const FListenerArray* Listeners = ListenersByCooldownTag.Find(GrantedTag))
+		{
+			for (const TWeakObjectPtr<UVM_GameplayAbility>& ListenerPtr : *Listeners)
+			{
+				MatchingListeners.AddUnique(ListenerPtr);
+			}
+		}
+	}
+
+	for (const TWeakObjectPtr<UVM_GameplayAbility>& ListenerPtr : MatchingListeners)
+	{
+		UVM_GameplayAbility* ViewModel = ListenerPtr.Get();
+		if (ViewModel && Registrations.Contains(ViewModel))
+		{
+			ViewModel->OnActiveGameplayEffectAdded(AbilitySystemComponent, GameplayEffectSpec, ActiveGameplayEffectHandle);
+		}
+	}
+}
+
+void UAbilitySystemViewModelRouter::OnAnyGameplayEffectRemoved(const FActiveGameplayEffect& ActiveGameplayEffect)
+{
+	Dispatch(ListenersByCooldownEffect.Find(ActiveGameplayEffect.Handle), [&ActiveGameplayEffect](UVM_GameplayAbility* ViewModel)
+	{
+		ViewModel->OnActiveCooldownEffectRemoved(ActiveGameplayEffect);
+	});
+}
+
+void UAbilitySystemViewModelRouter::OnCooldownTagChanged(FGameplayTag GameplayTag, int32 NewCount)
+{
+	Dispatch(ListenersByCooldownTag.Find(GameplayTag), [GameplayTag, NewCount](UVM_GameplayAbility* ViewModel)
+	{
+		ViewModel->OnCooldownTagChanged(GameplayTag, NewCount);
+	});
+}
+
+void UAbilitySystemViewModelRouter::OnAnyTagChanged(FGameplayTag GameplayTag, int32 NewCount)
+{
+	const auto NotifyActivationTagChanged = [GameplayTag, NewCount](UVM_GameplayAbility* ViewModel)
+	{
+		ViewModel->OnActivationTagChanged(GameplayTag, NewCount);
+	};
+	Dispatch(ListenersByActivationTag.Find(GameplayTag), NotifyActivationTagChanged);
+	Dispatch(&AllTagListeners, NotifyActivationTagChanged);
+}
+
+void UAbilitySystemViewModelRouter::OnCostAttributeChanged(const FOnAttributeChangeData& AttributeChangeData)
+{
+	Dispatch(ListenersByCostAttribute.Find(AttributeChangeData.Attribute), [&AttributeChangeData](UVM_GameplayAbility* ViewModel)
+	{
+		ViewModel->OnCostAttributeChanged(AttributeChangeData);
+	});
+}
+
+void UAbilitySystemViewModelRouter::OnAbilityBlockTagsChanged(const FGameplayTagContainer& BlockTags)
+{
+	// only abilities with an asset tag (or parent tag) matching a block tag can be affected
+	TArray<TWeakObjectPtr<UVM_GameplayAbility>, TInlineAllocator<8>> AffectedViewModels;
+	for (const FGameplayTag& BlockTag : BlockTags)
+	{
+		if (const FListenerArray* Listeners = ListenersByAbilityTag.Find(BlockTag))
+		{
+			for (const TWeakObjectPtr<UVM_GameplayAbility>& ListenerPtr : *Listeners)
+			{
+				AffectedViewModels.AddUnique(ListenerPtr);
+			}
+		}
+	}
+
+	UpdateBlockedAbilities(AffectedViewModels);
+}
+
+void UAbilitySystemViewModelRouter::OnAbilityTagRelationshipMappingChanged()
+{
+	TArray<TWeakObjectPtr<UVM_GameplayAbility>, TInlineAllocator<8>> ViewModels;
+	ViewModels.Reserve(Registrations.Num());
+	for (const auto& Elem : Registrations)
+	{
+		ViewModels.Add(Elem.Key.ResolveObjectPtr());
+	}
+
+	for (const TWeakObjectPtr<UVM_GameplayAbility>& ViewModelPtr : ViewModels)
+	{
+		if (UVM_GameplayAbility* ViewModel = ViewModelPtr.Get())
+		{
+			RegisterAbilityViewModel(ViewModel);
+			ViewModel->InvalidateCanActivate();
+		}
+	}
+}
\ No newline at end of file
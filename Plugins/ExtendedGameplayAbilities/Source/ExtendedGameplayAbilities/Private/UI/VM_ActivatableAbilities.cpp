@@ -21,24 +21,38 @@ void UVM_ActivatableAbilities::PreSystemChange()
 		ASC->OnGiveAbilityEvent.RemoveAll(this);
 		ASC->OnRemoveAbilityEvent.RemoveAll(this);
 	}
+	AbilityTagCache.Reset();
 
 	Super::PreSystemChange();
 }
 
 void UVM_ActivatableAbilities::PostSystemChange()
 {
-	if (UExtendedAbilitySystemComponent* ASC = GetAbilitySystem<UExtendedAbilitySystemComponent>())
+	if (!AreUpdatesSuspended())
 	{
-		ASC->OnGiveAbilityEvent.AddUObject(this, &UVM_ActivatableAbilities::OnGiveAbility);
-		ASC->OnRemoveAbilityEvent.AddUObject(this, &UVM_ActivatableAbilities::OnRemoveAbility);
+		if (UExtendedAbilitySystemComponent* ASC = GetAbilitySystem<UExtendedAbilitySystemComponent>())
+		{
+			ASC->OnGiveAbilityEvent.AddUObject(this, &UVM_ActivatableAbilities::OnGiveAbility);
+			ASC->OnRemoveAbilityEvent.AddUObject(this, &UVM_ActivatableAbilities::OnRemoveAbility);
+		}
+
+		RefreshAbilityViewModels();
 	}
 
 	Super::PostSystemChange();
 
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilitySpecHandles);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilityViewModels);
+	BroadcastAbilitiesChanged();
+}
 
-	OnAbilitiesChangedEvent.Broadcast();
+void UVM_ActivatableAbilities::OnUpdatesSuspendedChanged()
+{
+	Super::OnUpdatesSuspendedChanged();
+
+	// suspend or resume ability view models along with the list
+	for (UVM_GameplayAbility* AbilityViewModel : AbilityViewModels)
+	{
+		AbilityViewModel->SetUpdatesSuspended(AreUpdatesSuspended());
+	}
 }
 
 void UVM_ActivatableAbilities::SetAbilityTagQuery(const FGameplayTagQuery& NewTagQuery)
@@ -50,52 +64,42 @@ void UVM_ActivatableAbilities::SetAbilityTagQuery(const FGameplayTagQuery& NewTa
 
 	AbilityTagQuery = NewTagQuery;
 
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(AbilityTagQuery);
+	// combined tags are still valid, but memoized matches are not
+	for (auto& Elem : AbilityTagCache)
+	{
+		Elem.Value.bMatchesQuery.Reset();
+	}
 
-	if (AbilitySystem.IsValid())
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(AbilityTagQuery);
+
+	// when suspended, abilities are refreshed on resume
+	if (AbilitySystem.IsValid() && !AreUpdatesSuspended())
 	{
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilitySpecHandles);
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilityViewModels);
-		OnAbilitiesChangedEvent.Broadcast();
+		RefreshAbilityViewModels();
+		BroadcastAbilitiesChanged();
 	}
 }
 
 TArray<FGameplayAbilitySpecHandle> UVM_ActivatableAbilities::GetAbilitySpecHandles() const
 {
+	// the view models are kept in sync with included abilities
 	TArray<FGameplayAbilitySpecHandle> Result;
-	if (AbilitySystem.IsValid())
+	Result.Reserve(AbilityViewModels.Num());
+	for (const UVM_GameplayAbility* AbilityViewModel : AbilityViewModels)
 	{
-		for (const FGameplayAbilitySpec& AbilitySpec : AbilitySystem->GetActivatableAbilities())
-		{
-			if (ShouldIncludeAbility(AbilitySpec))
-			{
-				Result.Add(AbilitySpec.Handle);
-			}
-		}
+		Result.Add(AbilityViewModel->GetAbilitySpecHandle());
 	}
 	return Result;
 }
 
-
 TArray<UVM_GameplayAbility*> UVM_ActivatableAbilities::GetAbilityViewModels() const
 {
-	TArray<UVM_GameplayAbility*> Result;
-	if (UAbilitySystemComponent* ASC = AbilitySystem.Get())
-	{
-		UVM_ActivatableAbilities* MutableThis = const_cast<UVM_ActivatableAbilities*>(this);
+	return ObjectPtrDecay(AbilityViewModels);
+}
 
-		Result.Reserve(ASC->GetActivatableAbilities().Num());
-		for (const FGameplayAbilitySpec& AbilitySpec : ASC->GetActivatableAbilities())
-		{
-			if (ShouldIncludeAbility(AbilitySpec))
-			{
-				UVM_GameplayAbility* AbilityViewModel = NewObject<UVM_GameplayAbility>(MutableThis, NAME_None, RF_Transient);
-				AbilityViewModel->SetAbilitySystemAndSpecHandle(ASC, AbilitySpec.Handle);
-				Result.Add(AbilityViewModel);
-			}
-		}
-	}
-	return Result;
+UVM_GameplayAbility* UVM_ActivatableAbilities::FindAbilityViewModel(FGameplayAbilitySpecHandle AbilitySpecHandle) const
+{
+	return AbilityViewModelsByHandle.FindRef(AbilitySpecHandle);
 }
 
 FGameplayAbilitySpecHandle UVM_ActivatableAbilities::FindAbilityMatchingTags(FGameplayTagContainer MatchingTags, FGameplayTagContainer IgnoreTags) const
@@ -106,9 +110,7 @@ FGameplayAbilitySpecHandle UVM_ActivatableAbilities::FindAbilityMatchingTags(FGa
 		{
 			if (ShouldIncludeAbility(AbilitySpec))
 			{
-				FGameplayTagContainer AbilityTags;
-				AbilityTags.AppendTags(AbilitySpec.Ability->GetAssetTags());
-				AbilityTags.AppendTags(AbilitySpec.GetDynamicSpecSourceTags());
+				const FGameplayTagContainer& AbilityTags = GetAbilityTagCacheEntry(AbilitySpec).AbilityTags;
 				if (AbilityTags.HasAny(MatchingTags) && !AbilityTags.HasAny(IgnoreTags))
 				{
 					return AbilitySpec.Handle;
@@ -126,34 +128,140 @@ bool UVM_ActivatableAbilities::ShouldIncludeAbility(const FGameplayAbilitySpec&
 		return false;
 	}
 
-	if (!AbilityTagQuery.IsEmpty())
+	if (!AbilityTagQuery.IsEmpty() && !MatchesAbilityTagQuery(AbilitySpec))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+UVM_ActivatableAbilities::FAbilityTagCacheEntry& UVM_ActivatableAbilities::GetAbilityTagCacheEntry(const FGameplayAbilitySpec& AbilitySpec) const
+{
+	FAbilityTagCacheEntry& Entry = AbilityTagCache.FindOrAdd(AbilitySpec.Handle);
+
+	const TObjectKey<UGameplayAbility> AbilityKey(AbilitySpec.Ability.Get());
+	const FGameplayTagContainer& DynamicTags = AbilitySpec.GetDynamicSpecSourceTags();
+	if (Entry.Ability != AbilityKey || Entry.DynamicTags != DynamicTags)
 	{
-		FGameplayTagContainer AbilityTags;
-		AbilityTags.AppendTags(AbilitySpec.Ability->GetAssetTags());
-		AbilityTags.AppendTags(AbilitySpec.GetDynamicSpecSourceTags());
-		if (!AbilityTagQuery.Matches(AbilityTags))
+		Entry.Ability = AbilityKey;
+		Entry.DynamicTags = DynamicTags;
+		Entry.AbilityTags.Reset();
+		if (AbilitySpec.Ability)
 		{
-			return false;
+			Entry.AbilityTags.AppendTags(AbilitySpec.Ability->GetAssetTags());
 		}
+		Entry.AbilityTags.AppendTags(DynamicTags);
+		Entry.bMatchesQuery.Reset();
 	}
 
-	return true;
+	return Entry;
+}
+
+bool UVM_ActivatableAbilities::MatchesAbilityTagQuery(const FGameplayAbilitySpec& AbilitySpec) const
+{
+	FAbilityTagCacheEntry& Entry = GetAbilityTagCacheEntry(AbilitySpec);
+	if (!Entry.bMatchesQuery.IsSet())
+	{
+		Entry.bMatchesQuery = AbilityTagQuery.Matches(Entry.AbilityTags);
+	}
+	return Entry.bMatchesQuery.GetValue();
 }
 
 void UVM_ActivatableAbilities::OnGiveAbility(FGameplayAbilitySpec& GameplayAbilitySpec)
 {
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilitySpecHandles);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilityViewModels);
-	OnAbilitiesChangedEvent.Broadcast();
+	AbilityTagCache.Remove(GameplayAbilitySpec.Handle);
+
+	if (!AbilityViewModelsByHandle.Contains(GameplayAbilitySpec.Handle) && ShouldIncludeAbility(GameplayAbilitySpec))
+	{
+		AddAbilityViewModel(GameplayAbilitySpec.Handle);
+		BroadcastAbilitiesChanged();
+	}
 }
 
 void UVM_ActivatableAbilities::OnRemoveAbility(FGameplayAbilitySpec& GameplayAbilitySpec)
 {
-	AbilityBeingRemoved = GameplayAbilitySpec.Handle;
+	AbilityTagCache.Remove(GameplayAbilitySpec.Handle);
 
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilitySpecHandles);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilityViewModels);
-	OnAbilitiesChangedEvent.Broadcast();
+	if (AbilityViewModelsByHandle.Contains(GameplayAbilitySpec.Handle))
+	{
+		TGuardValue<FGameplayAbilitySpecHandle> AbilityBeingRemovedGuard(AbilityBeingRemoved, GameplayAbilitySpec.Handle);
 
-	AbilityBeingRemoved = FGameplayAbilitySpecHandle();
+		RemoveAbilityViewModel(GameplayAbilitySpec.Handle);
+		BroadcastAbilitiesChanged();
+	}
+}
+
+void UVM_ActivatableAbilities::RefreshAbilityViewModels()
+{
+	UAbilitySystemComponent* ASC = AbilitySystem.Get();
+
+	TSet<FGameplayAbilitySpecHandle> IncludedHandles;
+	if (ASC)
+	{
+		for (const FGameplayAbilitySpec& AbilitySpec : ASC->GetActivatableAbilities())
+		{
+			if (ShouldIncludeAbility(AbilitySpec))
+			{
+				IncludedHandles.Add(AbilitySpec.Handle);
+			}
+		}
+	}
+
+	// retire view models for abilities that are no longer included, or belong to a previous ability system
+	for (int32 Idx = AbilityViewModels.Num() - 1; Idx >= 0; --Idx)
+	{
+		const UVM_GameplayAbility* AbilityViewModel = AbilityViewModels[Idx];
+		if (AbilityViewModel->GetAbilitySystem() != ASC || !IncludedHandles.Contains(AbilityViewModel->GetAbilitySpecHandle()))
+		{
+			RemoveAbilityViewModel(AbilityViewModel->GetAbilitySpecHandle());
+		}
+	}
+
+	// add view models for newly included abilities, preserving the order of existing ones
+	if (ASC)
+	{
+		for (const FGameplayAbilitySpec& AbilitySpec : ASC->GetActivatableAbilities())
+		{
+			if (IncludedHandles.Contains(AbilitySpec.Handle) && !AbilityViewModelsByHandle.Contains(AbilitySpec.Handle))
+			{
+				AddAbilityViewModel(AbilitySpec.Handle);
+			}
+		}
+	}
+}
+
+UVM_GameplayAbility* UVM_ActivatableAbilities::AddAbilityViewModel(FGameplayAbilitySpecHandle AbilitySpecHandle)
+{
+	UVM_GameplayAbility* AbilityViewModel = NewObject<UVM_GameplayAbility>(this, NAME_None, RF_Transient);
+	AbilityViewModel->SetAbilitySystemAndSpecHandle(AbilitySystem.Get(), AbilitySpecHandle);
+
+	AbilityViewModels.Add(AbilityViewModel);
+	AbilityViewModelsByHandle.Add(AbilitySpecHandle, AbilityViewModel);
+
+	OnAbilityViewModelAddedEvent.Broadcast(AbilityViewModel);
+	return AbilityViewModel;
+}
+
+void UVM_ActivatableAbilities::RemoveAbilityViewModel(FGameplayAbilitySpecHandle AbilitySpecHandle)
+{
+	TObjectPtr<UVM_GameplayAbility> AbilityViewModel;
+	if (!AbilityViewModelsByHandle.RemoveAndCopyValue(AbilitySpecHandle, AbilityViewModel))
+	{
+		return;
+	}
+
+	AbilityViewModels.Remove(AbilityViewModel);
+
+	// unbind from the ability system
+	AbilityViewModel->SetAbilitySystemAndSpecHandle(nullptr, FGameplayAbilitySpecHandle());
+
+	OnAbilityViewModelRemovedEvent.Broadcast(AbilityViewModel);
+}
+
+void UVM_ActivatableAbilities::BroadcastAbilitiesChanged()
+{
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilitySpecHandles);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilityViewModels);
+	OnAbilitiesChangedEvent.Broadcast();
 }
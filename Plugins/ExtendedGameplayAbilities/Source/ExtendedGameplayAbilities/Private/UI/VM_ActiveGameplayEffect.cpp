@@ -21,17 +21,49 @@ void UVM_ActiveGameplayEffect::SetActiveEffectHandle(FActiveGameplayEffectHandle
 		return;
 	}
 
-	if (FActiveGameplayEffectEvents* EventSet = GetActiveEffectEventSet())
+	if (!bUpdatesSuspended)
 	{
-		EventSet->OnEffectRemoved.RemoveAll(this);
-		EventSet->OnStackChanged.RemoveAll(this);
-		EventSet->OnTimeChanged.RemoveAll(this);
-		EventSet->OnInhibitionChanged.RemoveAll(this);
+		UnbindFromEffectEvents();
 	}
 
 	ActiveEffectHandle = NewHandle;
 	RemovalInfo = FGameplayEffectRemovalInfo();
 
+	const UAbilitySystemComponent* AbilitySystem = ActiveEffectHandle.GetOwningAbilitySystemComponent();
+	CachedWorld = AbilitySystem ? AbilitySystem->GetWorld() : nullptr;
+	UpdateCachedTiming();
+
+	if (!bUpdatesSuspended)
+	{
+		BindToEffectEvents();
+	}
+
+	BroadcastEffectFields();
+}
+
+void UVM_ActiveGameplayEffect::SetUpdatesSuspended(bool bNewUpdatesSuspended)
+{
+	if (bUpdatesSuspended == bNewUpdatesSuspended)
+	{
+		return;
+	}
+
+	bUpdatesSuspended = bNewUpdatesSuspended;
+	if (bUpdatesSuspended)
+	{
+		UnbindFromEffectEvents();
+	}
+	else
+	{
+		// timing and stacks may have changed while suspended
+		UpdateCachedTiming();
+		BindToEffectEvents();
+		BroadcastEffectFields();
+	}
+}
+
+void UVM_ActiveGameplayEffect::BindToEffectEvents()
+{
 	if (FActiveGameplayEffectEvents* EventSet = GetActiveEffectEventSet())
 	{
 		EventSet->OnEffectRemoved.AddUObject(this, &ThisClass::OnEffectRemoved);
@@ -39,7 +71,21 @@ void UVM_ActiveGameplayEffect::SetActiveEffectHandle(FActiveGameplayEffectHandle
 		EventSet->OnTimeChanged.AddUObject(this, &ThisClass::OnEffectTimeChanged);
 		EventSet->OnInhibitionChanged.AddUObject(this, &ThisClass::OnEffectInhibitionChanged);
 	}
+}
 
+void UVM_ActiveGameplayEffect::UnbindFromEffectEvents()
+{
+	if (FActiveGameplayEffectEvents* EventSet = GetActiveEffectEventSet())
+	{
+		EventSet->OnEffectRemoved.RemoveAll(this);
+		EventSet->OnStackChanged.RemoveAll(this);
+		EventSet->OnTimeChanged.RemoveAll(this);
+		EventSet->OnInhibitionChanged.RemoveAll(this);
+	}
+}
+
+void UVM_ActiveGameplayEffect::BroadcastEffectFields()
+{
 	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(ActiveEffectHandle);
 	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetDuration);
 	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetEndTime);
@@ -75,31 +121,10 @@ int32 UVM_ActiveGameplayEffect::GetStackCount() const
 	return UAbilitySystemBlueprintLibrary::GetActiveGameplayEffectStackCount(ActiveEffectHandle);
 }
 
-float UVM_ActiveGameplayEffect::GetStartTime() const
-{
-	if (const FActiveGameplayEffect* ActiveEffect = GetActiveGameplayEffect())
-	{
-		return ActiveEffect->StartWorldTime;
-	}
-	return 0.f;
-}
-
-float UVM_ActiveGameplayEffect::GetDuration() const
-{
-	if (const FActiveGameplayEffect* ActiveEffect = GetActiveGameplayEffect())
-	{
-		return ActiveEffect->GetDuration();
-	}
-	return 0.f;
-}
-
 float UVM_ActiveGameplayEffect::GetEndTime() const
 {
-	if (const FActiveGameplayEffect* ActiveEffect = GetActiveGameplayEffect())
-	{
-		return ActiveEffect->GetEndTime();
-	}
-	return 0.f;
+	// matches FActiveGameplayEffect::GetEndTime
+	return CachedDuration == FGameplayEffectConstants::INFINITE_DURATION ? -1.f : CachedStartTime + CachedDuration;
 }
 
 bool UVM_ActiveGameplayEffect::IsInhibited() const
@@ -113,16 +138,37 @@ bool UVM_ActiveGameplayEffect::IsInhibited() const
 
 float UVM_ActiveGameplayEffect::GetTimeRemaining() const
 {
-	return FMath::Max(GetEndTime() - GetWorld()->GetTimeSeconds(), 0.f);
+	return FMath::Max(GetEndTime() - GetWorldTime(), 0.f);
 }
 
 float UVM_ActiveGameplayEffect::GetNormalizedTimeRemaining() const
+{
+	return CachedDuration > UE_SMALL_NUMBER ? FMath::Clamp(GetTimeRemaining() / CachedDuration, 0.f, 1.f) : 0.f;
+}
+
+void UVM_ActiveGameplayEffect::UpdateCachedTiming()
 {
 	if (const FActiveGameplayEffect* ActiveEffect = GetActiveGameplayEffect())
 	{
-		const float Duration = ActiveEffect->GetDuration();
-		const float TimeRemaining = FMath::Max(ActiveEffect->GetEndTime() - GetWorld()->GetTimeSeconds(), 0.f);
-		return Duration > UE_SMALL_NUMBER ? FMath::Clamp(TimeRemaining / Duration, 0.f, 1.f) : 0.f;
+		CachedStartTime = ActiveEffect->StartWorldTime;
+		CachedDuration = ActiveEffect->GetDuration();
+	}
+	else
+	{
+		CachedStartTime = 0.f;
+		CachedDuration = 0.f;
+	}
+}
+
+float UVM_ActiveGameplayEffect::GetWorldTime() const
+{
+	if (const UWorld* World = CachedWorld.Get())
+	{
+		return World->GetTimeSeconds();
+	}
+	if (const UWorld* World = GetWorld())
+	{
+		return World->GetTimeSeconds();
 	}
 	return 0.f;
 }
@@ -148,9 +194,14 @@ FActiveGameplayEffectEvents* UVM_ActiveGameplayEffect::GetActiveEffectEventSet()
 void UVM_ActiveGameplayEffect::OnEffectRemoved(const FGameplayEffectRemovalInfo& InRemovalInfo)
 {
 	RemovalInfo = InRemovalInfo;
+	CachedStartTime = 0.f;
+	CachedDuration = 0.f;
 
 	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetStackCount);
 	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(RemovalInfo);
+	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetDuration);
+	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetStartTime);
+	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetEndTime);
 }
 
 void UVM_ActiveGameplayEffect::OnEffectStackChanged(FActiveGameplayEffectHandle Handle, int32 NewStackCount, int32 OldStackCount)
@@ -170,6 +221,9 @@ void UVM_ActiveGameplayEffect::OnEffectTimeChanged(FActiveGameplayEffectHandle H
 		return;
 	}
 
+	CachedStartTime = NewStartTime;
+	CachedDuration = NewDuration;
+
 	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetDuration);
 	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetStartTime);
 	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetEndTime);
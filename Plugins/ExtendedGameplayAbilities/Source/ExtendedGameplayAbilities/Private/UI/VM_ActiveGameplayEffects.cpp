@@ -14,7 +14,7 @@ void UVM_ActiveGameplayEffects::SetEffectQuery(const FGameplayEffectQuery& NewQu
 	EffectQuery = NewQuery;
 	PostSystemChange();
 
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(EffectQuery);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(EffectQuery);
 }
 
 void UVM_ActiveGameplayEffects::SetRequiredUIDataClass(TSubclassOf<UGameplayEffectUIData> NewRequireUIDataClass)
@@ -22,14 +22,25 @@ void UVM_ActiveGameplayEffects::SetRequiredUIDataClass(TSubclassOf<UGameplayEffe
 	if (RequiredUIDataClass != NewRequireUIDataClass)
 	{
 		RequiredUIDataClass = NewRequireUIDataClass;
+		HasRequiredUIDataCache.Reset();
 
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(RequiredUIDataClass);
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveEffects);
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveEffectViewModels);
+		ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(RequiredUIDataClass);
+
+		// when suspended, effects are refreshed on resume
+		if (!AreUpdatesSuspended())
+		{
+			RefreshEffectViewModels();
+			BroadcastEffectsChanged();
+		}
 	}
 }
 
 TArray<FActiveGameplayEffectHandle> UVM_ActiveGameplayEffects::GetActiveEffects() const
+{
+	return ActiveEffectHandles;
+}
+
+TArray<FActiveGameplayEffectHandle> UVM_ActiveGameplayEffects::FindIncludedEffects() const
 {
 	TArray<FActiveGameplayEffectHandle> Result;
 	if (AbilitySystem.IsValid())
@@ -37,15 +48,10 @@ TArray<FActiveGameplayEffectHandle> UVM_ActiveGameplayEffects::GetActiveEffects(
 		for (FActiveGameplayEffectsContainer::ConstIterator EffectIt = AbilitySystem->GetActiveGameplayEffects().CreateConstIterator(); EffectIt; ++EffectIt)
 		{
 			const FActiveGameplayEffect& Effect = *EffectIt;
-			if (!EffectQuery.Matches(Effect))
-			{
-				continue;
-			}
-			if (RequiredUIDataClass && (!Effect.Spec.Def || !Effect.Spec.Def->FindComponent(RequiredUIDataClass)))
+			if (ShouldIncludeEffect(Effect))
 			{
-				continue;
+				Result.Add(Effect.Handle);
 			}
-			Result.Add(Effect.Handle);
 		}
 	}
 	return Result;
@@ -53,21 +59,12 @@ TArray<FActiveGameplayEffectHandle> UVM_ActiveGameplayEffects::GetActiveEffects(
 
 TArray<UVM_ActiveGameplayEffect*> UVM_ActiveGameplayEffects::GetActiveEffectViewModels() const
 {
-	TArray<UVM_ActiveGameplayEffect*> Result;
-	TArray<FActiveGameplayEffectHandle> ActiveEffects = GetActiveEffects();
-	if (!ActiveEffects.IsEmpty())
-	{
-		UVM_ActiveGameplayEffects* MutableThis = const_cast<UVM_ActiveGameplayEffects*>(this);
+	return ObjectPtrDecay(EffectViewModels);
+}
 
-		Result.Reserve(ActiveEffects.Num());
-		for (const FActiveGameplayEffectHandle& ActiveEffect : ActiveEffects)
-		{
-			UVM_ActiveGameplayEffect* EffectViewModel = NewObject<UVM_ActiveGameplayEffect>(MutableThis, NAME_None, RF_Transient);
-			EffectViewModel->SetActiveEffectHandle(ActiveEffect);
-			Result.Add(EffectViewModel);
-		}
-	}
-	return Result;
+UVM_ActiveGameplayEffect* UVM_ActiveGameplayEffects::FindEffectViewModel(FActiveGameplayEffectHandle EffectHandle) const
+{
+	return EffectViewModelsByHandle.FindRef(EffectHandle);
 }
 
 void UVM_ActiveGameplayEffects::PreSystemChange()
@@ -83,38 +80,151 @@ void UVM_ActiveGameplayEffects::PreSystemChange()
 
 void UVM_ActiveGameplayEffects::PostSystemChange()
 {
-	if (UAbilitySystemComponent* ASC = GetAbilitySystem<UAbilitySystemComponent>())
+	if (!AreUpdatesSuspended())
 	{
-		ASC->OnActiveGameplayEffectAddedDelegateToSelf.AddUObject(this, &UVM_ActiveGameplayEffects::OnActiveGameplayEffectAdded);
-		ASC->OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &UVM_ActiveGameplayEffects::OnAnyGameplayEffectRemoved);
+		if (UAbilitySystemComponent* ASC = GetAbilitySystem<UAbilitySystemComponent>())
+		{
+			ASC->OnActiveGameplayEffectAddedDelegateToSelf.AddUObject(this, &UVM_ActiveGameplayEffects::OnActiveGameplayEffectAdded);
+			ASC->OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &UVM_ActiveGameplayEffects::OnAnyGameplayEffectRemoved);
+		}
+
+		RefreshEffectViewModels();
 	}
 
 	Super::PostSystemChange();
 
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveEffects);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveEffectViewModels);
+	BroadcastEffectsChanged();
+}
+
+void UVM_ActiveGameplayEffects::OnUpdatesSuspendedChanged()
+{
+	Super::OnUpdatesSuspendedChanged();
+
+	// suspend or resume effect view models along with the list
+	for (UVM_ActiveGameplayEffect* EffectViewModel : EffectViewModels)
+	{
+		EffectViewModel->SetUpdatesSuspended(AreUpdatesSuspended());
+	}
+}
+
+bool UVM_ActiveGameplayEffects::ShouldIncludeEffect(const FActiveGameplayEffect& ActiveEffect) const
+{
+	if (!EffectQuery.Matches(ActiveEffect))
+	{
+		return false;
+	}
+
+	if (RequiredUIDataClass && !HasRequiredUIData(ActiveEffect.Spec.Def))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool UVM_ActiveGameplayEffects::HasRequiredUIData(const UGameplayEffect* EffectDef) const
+{
+	if (!EffectDef)
+	{
+		return false;
+	}
+
+	if (const bool* bCachedResult = HasRequiredUIDataCache.Find(EffectDef))
+	{
+		return *bCachedResult;
+	}
+
+	// effect definitions are assets or class defaults, so their components don't change at runtime
+	const bool bHasUIData = EffectDef->FindComponent(RequiredUIDataClass) != nullptr;
+	HasRequiredUIDataCache.Add(EffectDef, bHasUIData);
+	return bHasUIData;
+}
+
+void UVM_ActiveGameplayEffects::RefreshEffectViewModels()
+{
+	const TArray<FActiveGameplayEffectHandle> ActiveEffects = FindIncludedEffects();
+	const TSet<FActiveGameplayEffectHandle> ActiveEffectsSet(ActiveEffects);
+
+	// retire view models for effects that are no longer included
+	for (int32 Idx = EffectViewModels.Num() - 1; Idx >= 0; --Idx)
+	{
+		const FActiveGameplayEffectHandle EffectHandle = EffectViewModels[Idx]->GetActiveEffectHandle();
+		if (!ActiveEffectsSet.Contains(EffectHandle))
+		{
+			RemoveEffectViewModel(EffectHandle, false);
+		}
+	}
+
+	// add view models for newly included effects, preserving the order of existing ones
+	for (const FActiveGameplayEffectHandle& EffectHandle : ActiveEffects)
+	{
+		if (!EffectViewModelsByHandle.Contains(EffectHandle))
+		{
+			AddEffectViewModel(EffectHandle);
+		}
+	}
+}
+
+UVM_ActiveGameplayEffect* UVM_ActiveGameplayEffects::AddEffectViewModel(FActiveGameplayEffectHandle EffectHandle)
+{
+	UVM_ActiveGameplayEffect* EffectViewModel = NewObject<UVM_ActiveGameplayEffect>(this, NAME_None, RF_Transient);
+	EffectViewModel->SetActiveEffectHandle(EffectHandle);
+
+	EffectViewModels.Add(EffectViewModel);
+	EffectViewModelsByHandle.Add(EffectHandle, EffectViewModel);
+	ActiveEffectHandles.Add(EffectHandle);
+
+	OnEffectViewModelAddedEvent.Broadcast(EffectViewModel);
+	return EffectViewModel;
+}
+
+void UVM_ActiveGameplayEffects::RemoveEffectViewModel(FActiveGameplayEffectHandle EffectHandle, bool bEffectRemoved)
+{
+	TObjectPtr<UVM_ActiveGameplayEffect> EffectViewModel;
+	if (!EffectViewModelsByHandle.RemoveAndCopyValue(EffectHandle, EffectViewModel))
+	{
+		return;
+	}
+
+	EffectViewModels.Remove(EffectViewModel);
+	ActiveEffectHandles.Remove(EffectHandle);
+
+	if (!bEffectRemoved)
+	{
+		// the effect is still active, so unbind from its events.
+		// removed effects keep their handle so that RemovalInfo remains meaningful.
+		EffectViewModel->SetActiveEffectHandle(FActiveGameplayEffectHandle());
+	}
+
+	OnEffectViewModelRemovedEvent.Broadcast(EffectViewModel);
+}
+
+void UVM_ActiveGameplayEffects::BroadcastEffectsChanged()
+{
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveEffects);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveEffectViewModels);
 }
 
 void UVM_ActiveGameplayEffects::OnActiveGameplayEffectAdded(UAbilitySystemComponent* AbilitySystemComponent,
                                                             const FGameplayEffectSpec& GameplayEffectSpec,
                                                             FActiveGameplayEffectHandle ActiveGameplayEffectHandle)
 {
-	if (AbilitySystem.IsValid())
+	if (AbilitySystem.IsValid() && !EffectViewModelsByHandle.Contains(ActiveGameplayEffectHandle))
 	{
 		const FActiveGameplayEffect* ActiveEffect = AbilitySystem->GetActiveGameplayEffect(ActiveGameplayEffectHandle);
-		if (ActiveEffect && EffectQuery.Matches(*ActiveEffect))
+		if (ActiveEffect && ShouldIncludeEffect(*ActiveEffect))
 		{
-			UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveEffects);
-			UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveEffectViewModels);
+			AddEffectViewModel(ActiveGameplayEffectHandle);
+			BroadcastEffectsChanged();
 		}
 	}
 }
 
 void UVM_ActiveGameplayEffects::OnAnyGameplayEffectRemoved(const FActiveGameplayEffect& ActiveGameplayEffect)
 {
-	if (EffectQuery.Matches(ActiveGameplayEffect))
+	if (EffectViewModelsByHandle.Contains(ActiveGameplayEffect.Handle))
 	{
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveEffects);
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveEffectViewModels);
+		RemoveEffectViewModel(ActiveGameplayEffect.Handle, true);
+		BroadcastEffectsChanged();
 	}
 }
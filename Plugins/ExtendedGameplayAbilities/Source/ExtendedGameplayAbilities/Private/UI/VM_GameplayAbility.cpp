@@ -4,6 +4,9 @@
 #include "UI/VM_GameplayAbility.h"
 
 #include "AbilitySystemComponent.h"
+#include "ExtendedAbilitySystemComponent.h"
+#include "ExtendedGameplayAbility.h"
+#include "UI/AbilitySystemViewModelRouter.h"
 
 
 void UVM_GameplayAbility::SetAbilitySpecHandle(FGameplayAbilitySpecHandle NewAbilitySpecHandle)
@@ -24,70 +27,56 @@ void UVM_GameplayAbility::SetAbilitySystemAndSpecHandle(UAbilitySystemComponent*
 
 void UVM_GameplayAbility::PreSystemChange()
 {
-	if (UAbilitySystemComponent* ASC = AbilitySystem.Get())
+	if (Router)
 	{
-		ASC->AbilityActivatedCallbacks.RemoveAll(this);
-		ASC->OnAbilityEnded.RemoveAll(this);
-		ASC->OnActiveGameplayEffectAddedDelegateToSelf.RemoveAll(this);
-		ASC->RegisterGenericGameplayTagEvent().RemoveAll(this);
-
-		for (const FGameplayAttribute& Attribute : RegisteredCostAttributes)
-		{
-			ASC->GetGameplayAttributeValueChangeDelegate(Attribute).RemoveAll(this);
-		}
-
-		for (const FGameplayTag& CooldownTag : RegisteredCooldownTags)
-		{
-			ASC->RegisterGameplayTagEvent(CooldownTag).RemoveAll(this);
-		}
+		Router->UnregisterAbilityViewModel(this);
+		Router = nullptr;
 	}
-	RegisteredCostAttributes.Reset();
-	RegisteredCooldownTags.Reset();
+	UnbindFromActiveCooldownEffect();
+	CooldownTags.Reset();
+	ActiveCooldownEffect.Invalidate();
+	ActiveCooldownEffectEndTime = 0.f;
 
 	Super::PreSystemChange();
 }
 
 void UVM_GameplayAbility::PostSystemChange()
 {
-	// these bindings are specific to the current ability spec handle, not just the ability system
-	if (UAbilitySystemComponent* ASC = AbilitySystem.Get())
+	// activation, cooldown, and cost events are routed by a shared router that is bound once per ability system,
+	// registered using the current spec handle, cooldown tags, cooldown effect, and cost attributes
+	UAbilitySystemComponent* ASC = AbilitySystem.Get();
+	if (ASC && !AreUpdatesSuspended())
 	{
-		// listen for ability activation
-		ASC->AbilityActivatedCallbacks.AddUObject(this, &UVM_GameplayAbility::OnAnyAbilityActivated);
-		ASC->OnAbilityEnded.AddUObject(this, &UVM_GameplayAbility::OnAnyAbilityEnded);
-		// listen for cooldown effects being applied
-		ASC->OnActiveGameplayEffectAddedDelegateToSelf.AddUObject(this, &UVM_GameplayAbility::OnActiveGameplayEffectAdded);
-		// listen for any tag change for CanActivate
-		ASC->RegisterGenericGameplayTagEvent().AddUObject(this, &UVM_GameplayAbility::OnAnyTagChanged);
-
-		// listen for cost attribute changes for CanActivate
-		RegisteredCostAttributes = GetCostAttributes();
-		for (const FGameplayAttribute& Attribute : GetCostAttributes())
+		const FGameplayAbilitySpec* AbilitySpec = GetAbilitySpec();
+		if (AbilitySpec && AbilitySpec->Ability)
 		{
-			ASC->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(this, &UVM_GameplayAbility::OnCostAttributeChanged);
+			if (const FGameplayTagContainer* AbilityCooldownTags = AbilitySpec->Ability->GetCooldownTags())
+			{
+				CooldownTags = *AbilityCooldownTags;
+			}
 		}
 
-		// listen for cooldown tags to update IsOnCooldown
-		RegisteredCooldownTags = GetCooldownTags();
-		for (const FGameplayTag& CooldownTag : RegisteredCooldownTags)
-		{
-			ASC->RegisterGameplayTagEvent(CooldownTag).AddUObject(this, &UVM_GameplayAbility::OnCooldownTagChanged);
-		}
+		// find the initial cooldown effect, after which it's updated incrementally
+		ActiveCooldownEffect = FindActiveCooldownEffect(ActiveCooldownEffectEndTime);
+		BindToActiveCooldownEffect();
+
+		Router = UAbilitySystemViewModelRouter::GetOrCreate(ASC);
+		Router->RegisterAbilityViewModel(this);
 	}
 
 	Super::PostSystemChange();
 
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(AbilitySpecHandle);
-
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(CanActivate);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilityCDO);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilityClass);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveCooldownEffect);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetCooldownTags);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetCostAttributes);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(HasAbility);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(IsActive);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(IsOnCooldown);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(AbilitySpecHandle);
+
+	InvalidateCanActivate();
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilityCDO);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetAbilityClass);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveCooldownEffect);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetCooldownTags);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetCostAttributes);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(HasAbility);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(IsActive);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(IsOnCooldown);
 }
 
 bool UVM_GameplayAbility::HasAbility() const
@@ -109,6 +98,22 @@ bool UVM_GameplayAbility::IsActive() const
 }
 
 bool UVM_GameplayAbility::CanActivate() const
+{
+	if (bIsCanActivateDirty)
+	{
+		bCachedCanActivate = EvaluateCanActivate();
+		bIsCanActivateDirty = false;
+	}
+	return bCachedCanActivate;
+}
+
+void UVM_GameplayAbility::InvalidateCanActivate()
+{
+	bIsCanActivateDirty = true;
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(CanActivate);
+}
+
+bool UVM_GameplayAbility::EvaluateCanActivate() const
 {
 	FGameplayAbilitySpec* AbilitySpec = GetAbilitySpec();
 	if (AbilitySpec && AbilitySpec->Ability)
@@ -127,30 +132,13 @@ bool UVM_GameplayAbility::CanActivate() const
 
 bool UVM_GameplayAbility::IsOnCooldown() const
 {
-	if (AbilitySystem.IsValid())
+	if (AbilitySystem.IsValid() && !CooldownTags.IsEmpty())
 	{
-		const FGameplayTagContainer CooldownTags = GetCooldownTags();
-		if (!CooldownTags.IsEmpty())
-		{
-			return AbilitySystem->HasAnyMatchingGameplayTags(CooldownTags);
-		}
+		return AbilitySystem->HasAnyMatchingGameplayTags(CooldownTags);
 	}
 	return false;
 }
 
-FGameplayTagContainer UVM_GameplayAbility::GetCooldownTags() const
-{
-	const FGameplayAbilitySpec* AbilitySpec = GetAbilitySpec();
-	if (AbilitySpec && AbilitySpec->Ability)
-	{
-		if (const FGameplayTagContainer* CooldownTags = AbilitySpec->Ability->GetCooldownTags())
-		{
-			return *CooldownTags;
-		}
-	}
-	return FGameplayTagContainer();
-}
-
 TArray<FGameplayAttribute> UVM_GameplayAbility::GetCostAttributes() const
 {
 	TArray<FGameplayAttribute> Result;
@@ -171,32 +159,105 @@ TArray<FGameplayAttribute> UVM_GameplayAbility::GetCostAttributes() const
 	return Result;
 }
 
+bool UVM_GameplayAbility::GetActivationRelevantTags(FGameplayTagContainer& OutTags) const
+{
+	OutTags.Reset();
+	const FGameplayAbilitySpec* AbilitySpec = GetAbilitySpec();
+	if (!AbilitySpec || !AbilitySpec->Ability)
+	{
+		return true;
+	}
+
+	// activation required and blocked tags are only exposed by extended abilities
+	const UExtendedGameplayAbility* ExtendedAbility = Cast<UExtendedGameplayAbility>(AbilitySpec->Ability);
+	if (!ExtendedAbility)
+	{
+		return false;
+	}
+
+	OutTags.AppendTags(ExtendedAbility->GetActivationRequiredTags());
+	OutTags.AppendTags(ExtendedAbility->GetActivationBlockedTags());
+
+	// include additional requirements from the tag relationship mapping
+	if (const UExtendedAbilitySystemComponent* ExtendedAbilitySystem = GetAbilitySystem<UExtendedAbilitySystemComponent>())
+	{
+		FGameplayTagContainer AdditionalRequiredTags;
+		FGameplayTagContainer AdditionalBlockedTags;
+		ExtendedAbilitySystem->GetAdditionalActivationTagRequirements(AbilitySpec->Ability->GetAssetTags(), AdditionalRequiredTags, AdditionalBlockedTags);
+		OutTags.AppendTags(AdditionalRequiredTags);
+		OutTags.AppendTags(AdditionalBlockedTags);
+	}
+
+	return true;
+}
+
 FActiveGameplayEffectHandle UVM_GameplayAbility::GetActiveCooldownEffect() const
 {
-	const FGameplayTagContainer CooldownTags = GetCooldownTags();
-	if (!CooldownTags.IsEmpty())
+	return ActiveCooldownEffect;
+}
+
+FActiveGameplayEffectHandle UVM_GameplayAbility::FindActiveCooldownEffect(float& OutEndTime, FActiveGameplayEffectHandle IgnoreHandle) const
+{
+	FActiveGameplayEffectHandle BestEffect;
+	OutEndTime = 0.f;
+
+	if (AbilitySystem.IsValid() && !CooldownTags.IsEmpty())
 	{
 		const FGameplayEffectQuery Query = FGameplayEffectQuery::MakeQuery_MatchAnyOwningTags(CooldownTags);
 
-		FActiveGameplayEffectHandle BestEffect;
-		float BestEndTime = 0.f;
-
 		for (FActiveGameplayEffectsContainer::ConstIterator EffectIt = AbilitySystem->GetActiveGameplayEffects().CreateConstIterator(); EffectIt; ++EffectIt)
 		{
 			const FActiveGameplayEffect& Effect = *EffectIt;
-			if (Query.Matches(Effect))
+			if (Effect.Handle != IgnoreHandle && !Effect.IsPendingRemove && Query.Matches(Effect))
 			{
 				const float EndTime = Effect.GetEndTime();
-				if (!BestEffect.IsValid() || EndTime > BestEndTime)
+				if (!BestEffect.IsValid() || EndTime > OutEndTime)
 				{
 					BestEffect = Effect.Handle;
-					BestEndTime = EndTime;
+					OutEndTime = EndTime;
 				}
 			}
 		}
-		return BestEffect;
 	}
-	return FActiveGameplayEffectHandle();
+	return BestEffect;
+}
+
+void UVM_GameplayAbility::SetActiveCooldownEffect(FActiveGameplayEffectHandle NewCooldownEffect, float NewEndTime)
+{
+	ActiveCooldownEffectEndTime = NewEndTime;
+	if (ActiveCooldownEffect != NewCooldownEffect)
+	{
+		UnbindFromActiveCooldownEffect();
+		ActiveCooldownEffect = NewCooldownEffect;
+		BindToActiveCooldownEffect();
+		if (Router)
+		{
+			Router->UpdateCooldownEffect(this, ActiveCooldownEffect);
+		}
+		ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveCooldownEffect);
+	}
+}
+
+void UVM_GameplayAbility::BindToActiveCooldownEffect()
+{
+	if (AbilitySystem.IsValid() && ActiveCooldownEffect.IsValid())
+	{
+		if (FOnActiveGameplayEffectTimeChange* TimeChangeDelegate = AbilitySystem->OnGameplayEffectTimeChangeDelegate(ActiveCooldownEffect))
+		{
+			TimeChangeDelegate->AddUObject(this, &UVM_GameplayAbility::OnActiveCooldownEffectTimeChanged);
+		}
+	}
+}
+
+void UVM_GameplayAbility::UnbindFromActiveCooldownEffect()
+{
+	if (AbilitySystem.IsValid() && ActiveCooldownEffect.IsValid())
+	{
+		if (FOnActiveGameplayEffectTimeChange* TimeChangeDelegate = AbilitySystem->OnGameplayEffectTimeChangeDelegate(ActiveCooldownEffect))
+		{
+			TimeChangeDelegate->RemoveAll(this);
+		}
+	}
 }
 
 const UGameplayAbility* UVM_GameplayAbility::GetAbilityCDO() const
@@ -231,8 +292,8 @@ void UVM_GameplayAbility::OnAnyAbilityActivated(UGameplayAbility* GameplayAbilit
 	if (GameplayAbility->GetClass() == GetAbilityClass())
 	{
 		TGuardValue<bool> IsActivatingGuard(bIsActivating, true);
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(IsActive);
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(CanActivate);
+		ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(IsActive);
+		InvalidateCanActivate();
 	}
 }
 
@@ -240,40 +301,63 @@ void UVM_GameplayAbility::OnAnyAbilityEnded(const FAbilityEndedData& AbilityEnde
 {
 	if (AbilityEndedData.AbilitySpecHandle == AbilitySpecHandle)
 	{
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(IsActive);
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(CanActivate);
+		ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(IsActive);
+		InvalidateCanActivate();
 	}
 }
 
 void UVM_GameplayAbility::OnCostAttributeChanged(const FOnAttributeChangeData& AttributeChangeData)
 {
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(CanActivate);
+	InvalidateCanActivate();
 }
 
 void UVM_GameplayAbility::OnCooldownTagChanged(FGameplayTag GameplayTag, int32 NewCount)
 {
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(IsOnCooldown);
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(CanActivate);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(IsOnCooldown);
+	InvalidateCanActivate();
+
+	// the cooldown effect is gone once none of the cooldown tags remain
+	if (NewCount == 0 && ActiveCooldownEffect.IsValid() && !IsOnCooldown())
+	{
+		SetActiveCooldownEffect(FActiveGameplayEffectHandle(), 0.f);
+	}
 }
 
-void UVM_GameplayAbility::OnAnyTagChanged(FGameplayTag GameplayTag, int32 NewCount)
+void UVM_GameplayAbility::OnActivationTagChanged(FGameplayTag GameplayTag, int32 NewCount)
 {
-	// skip checking activation required / blocked tags to save effort
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(CanActivate);
+	// the router only dispatches tags from GetActivationRelevantTags
+	InvalidateCanActivate();
 }
 
 void UVM_GameplayAbility::OnActiveGameplayEffectAdded(UAbilitySystemComponent* AbilitySystemComponent,
                                                       const FGameplayEffectSpec& GameplayEffectSpec,
                                                       FActiveGameplayEffectHandle ActiveGameplayEffectHandle)
 {
-	if (AbilitySystem.Get() == AbilitySystemComponent)
+	// the router only dispatches effects that grant one of this ability's cooldown tags
+	if (const FActiveGameplayEffect* ActiveEffect = AbilitySystemComponent->GetActiveGameplayEffect(ActiveGameplayEffectHandle))
 	{
-		FGameplayTagContainer GrantedTags;
-		GameplayEffectSpec.GetAllGrantedTags(GrantedTags);
-		if (GrantedTags.HasAny(GetCooldownTags()))
+		const float EndTime = ActiveEffect->GetEndTime();
+		if (!ActiveCooldownEffect.IsValid() || EndTime > ActiveCooldownEffectEndTime)
 		{
-			UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetActiveCooldownEffect);
-			OnCooldownEffectAppliedEvent.Broadcast(ActiveGameplayEffectHandle);
+			SetActiveCooldownEffect(ActiveGameplayEffectHandle, EndTime);
 		}
 	}
+
+	OnCooldownEffectAppliedEvent.Broadcast(ActiveGameplayEffectHandle);
+}
+
+void UVM_GameplayAbility::OnActiveCooldownEffectRemoved(const FActiveGameplayEffect& ActiveGameplayEffect)
+{
+	// fall back to any other cooldown effect that is still active
+	float EndTime = 0.f;
+	const FActiveGameplayEffectHandle NewCooldownEffect = FindActiveCooldownEffect(EndTime, ActiveGameplayEffect.Handle);
+	SetActiveCooldownEffect(NewCooldownEffect, EndTime);
+}
+
+void UVM_GameplayAbility::OnActiveCooldownEffectTimeChanged(FActiveGameplayEffectHandle ActiveGameplayEffectHandle, float NewStartTime, float NewDuration)
+{
+	// the tracked effect may no longer end last, e.g. after its duration was reduced, so search again
+	float EndTime = 0.f;
+	const FActiveGameplayEffectHandle NewCooldownEffect = FindActiveCooldownEffect(EndTime);
+	SetActiveCooldownEffect(NewCooldownEffect, EndTime);
 }
@@ -6,6 +6,13 @@
 #include "AbilitySystemComponent.h"
 
 
+void UVM_GameplayAttribute::BeginDestroy()
+{
+	ClearPendingNotify();
+
+	Super::BeginDestroy();
+}
+
 void UVM_GameplayAttribute::SetAttribute(FGameplayAttribute NewAttribute)
 {
 	SetAbilitySystemAndAttribute(AbilitySystem.Get(), NewAttribute);
@@ -28,22 +35,23 @@ void UVM_GameplayAttribute::PreSystemChange()
 	{
 		AbilitySystem->GetGameplayAttributeValueChangeDelegate(Attribute).RemoveAll(this);
 	}
+	ClearPendingNotify();
 
 	Super::PreSystemChange();
 }
 
 void UVM_GameplayAttribute::PostSystemChange()
 {
-	if (AbilitySystem.IsValid() && Attribute.IsValid())
+	if (AbilitySystem.IsValid() && Attribute.IsValid() && !AreUpdatesSuspended())
 	{
 		AbilitySystem->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(this, &UVM_GameplayAttribute::OnAttributeValueChanged);
 	}
 
 	Super::PostSystemChange();
 
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(Attribute);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(Attribute);
 
-	UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetValue);
+	NotifyValueChanged(GetValue());
 }
 
 float UVM_GameplayAttribute::GetValue() const
@@ -64,6 +72,98 @@ void UVM_GameplayAttribute::OnAttributeValueChanged(const FOnAttributeChangeData
 {
 	if (ChangeData.Attribute == Attribute)
 	{
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetValue);
+		UpdateValueNotify();
+	}
+}
+
+void UVM_GameplayAttribute::UpdateValueNotify()
+{
+	const float NewValue = GetValue();
+	if (NewValue == LastNotifiedValue)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (FMath::Abs(NewValue - LastNotifiedValue) < ValueChangeTolerance)
+	{
+		// suppress small changes, only notifying once the value has settled
+		LastSuppressedChangeTime = Now;
+		SchedulePendingNotify(SettleDelay);
+		return;
+	}
+
+	if (MaxNotifyRate > 0.f)
+	{
+		// too soon, notify the latest value once the interval has passed
+		const double TimeUntilNextNotify = 1.0 / MaxNotifyRate - (Now - LastNotifyTime);
+		if (TimeUntilNextNotify > 0.0)
+		{
+			SchedulePendingNotify(TimeUntilNextNotify);
+			return;
+		}
+	}
+
+	NotifyValueChanged(NewValue);
+}
+
+void UVM_GameplayAttribute::SchedulePendingNotify(double Delay)
+{
+	const double NotifyTime = FPlatformTime::Seconds() + Delay;
+	if (PendingNotifyTickerHandle.IsValid())
+	{
+		if (PendingNotifyTime <= NotifyTime)
+		{
+			return;
+		}
+		ClearPendingNotify();
+	}
+
+	PendingNotifyTime = NotifyTime;
+	PendingNotifyTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UVM_GameplayAttribute::HandlePendingNotifyTicker), Delay);
+}
+
+void UVM_GameplayAttribute::NotifyValueChanged(float NewValue)
+{
+	ClearPendingNotify();
+
+	LastNotifiedValue = NewValue;
+	LastNotifyTime = FPlatformTime::Seconds();
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetValue);
+}
+
+void UVM_GameplayAttribute::ClearPendingNotify()
+{
+	if (PendingNotifyTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingNotifyTickerHandle);
+		PendingNotifyTickerHandle.Reset();
 	}
 }
+
+bool UVM_GameplayAttribute::HandlePendingNotifyTicker(float DeltaTime)
+{
+	// the ticker is removed after returning false, so just forget the handle
+	PendingNotifyTickerHandle.Reset();
+
+	const float NewValue = GetValue();
+	if (NewValue == LastNotifiedValue)
+	{
+		return false;
+	}
+
+	if (FMath::Abs(NewValue - LastNotifiedValue) < ValueChangeTolerance)
+	{
+		// keep waiting while small changes are still coming in
+		const double TimeUntilSettled = SettleDelay - (FPlatformTime::Seconds() - LastSuppressedChangeTime);
+		if (TimeUntilSettled > 0.0)
+		{
+			SchedulePendingNotify(TimeUntilSettled);
+			return false;
+		}
+	}
+
+	NotifyValueChanged(NewValue);
+	return false;
+}
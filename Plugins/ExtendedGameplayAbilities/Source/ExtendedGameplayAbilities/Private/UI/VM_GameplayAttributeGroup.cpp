@@ -0,0 +1,205 @@
+﻿// Copyright Bohdon Sayre, All Rights Reserved.
+
+
+#include "UI/VM_GameplayAttributeGroup.h"
+
+#include "AbilitySystemComponent.h"
+
+
+void UVM_GameplayAttributeGroup::BeginDestroy()
+{
+	ClearPendingNotify();
+
+	Super::BeginDestroy();
+}
+
+void UVM_GameplayAttributeGroup::SetAttributes(const TArray<FGameplayAttribute>& NewAttributes)
+{
+	SetAbilitySystemAndAttributes(AbilitySystem.Get(), NewAttributes);
+}
+
+void UVM_GameplayAttributeGroup::SetAbilitySystemAndAttributes(UAbilitySystemComponent* NewAbilitySystem, const TArray<FGameplayAttribute>& NewAttributes)
+{
+	if (AbilitySystem.Get() != NewAbilitySystem || Attributes != NewAttributes)
+	{
+		PreSystemChange();
+		Attributes = NewAttributes;
+		AbilitySystem = NewAbilitySystem;
+		PostSystemChange();
+	}
+}
+
+void UVM_GameplayAttributeGroup::PreSystemChange()
+{
+	if (UAbilitySystemComponent* ASC = AbilitySystem.Get())
+	{
+		for (const FGameplayAttribute& BoundAttribute : BoundAttributes)
+		{
+			ASC->GetGameplayAttributeValueChangeDelegate(BoundAttribute).RemoveAll(this);
+		}
+	}
+	BoundAttributes.Reset();
+	ClearPendingNotify();
+
+	Super::PreSystemChange();
+}
+
+void UVM_GameplayAttributeGroup::PostSystemChange()
+{
+	UAbilitySystemComponent* ASC = AbilitySystem.Get();
+	if (ASC && !AreUpdatesSuspended())
+	{
+		// the ability system only has per-attribute delegates, so bind each to the same handler
+		for (const FGameplayAttribute& GroupAttribute : Attributes)
+		{
+			if (GroupAttribute.IsValid() && !BoundAttributes.Contains(GroupAttribute))
+			{
+				ASC->GetGameplayAttributeValueChangeDelegate(GroupAttribute).AddUObject(this, &UVM_GameplayAttributeGroup::OnAttributeValueChanged);
+				BoundAttributes.Add(GroupAttribute);
+			}
+		}
+	}
+
+	Super::PostSystemChange();
+
+	LastNotifiedValues = GetValues();
+	LastNotifyTime = FPlatformTime::Seconds();
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(Attributes);
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetValues);
+}
+
+float UVM_GameplayAttributeGroup::GetAttributeValue(FGameplayAttribute InAttribute) const
+{
+	if (AbilitySystem.IsValid())
+	{
+		bool bFound;
+		const float Value = AbilitySystem->GetGameplayAttributeValue(InAttribute, bFound);
+		if (bFound)
+		{
+			return Value;
+		}
+	}
+	return 0.f;
+}
+
+TArray<float> UVM_GameplayAttributeGroup::GetValues() const
+{
+	TArray<float> Result;
+	Result.Reserve(Attributes.Num());
+	for (const FGameplayAttribute& GroupAttribute : Attributes)
+	{
+		Result.Add(GetAttributeValue(GroupAttribute));
+	}
+	return Result;
+}
+
+void UVM_GameplayAttributeGroup::OnAttributeValueChanged(const FOnAttributeChangeData& ChangeData)
+{
+	const int32 Idx = Attributes.IndexOfByKey(ChangeData.Attribute);
+	if (!LastNotifiedValues.IsValidIndex(Idx) || ChangeData.NewValue == LastNotifiedValues[Idx])
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (FMath::Abs(ChangeData.NewValue - LastNotifiedValues[Idx]) < ValueChangeTolerance)
+	{
+		// suppress small changes, only notifying once the values have settled
+		LastSuppressedChangeTime = Now;
+		SchedulePendingNotify(SettleDelay);
+		return;
+	}
+
+	if (MaxNotifyRate > 0.f)
+	{
+		// too soon, notify the latest values once the interval has passed
+		const double TimeUntilNextNotify = 1.0 / MaxNotifyRate - (Now - LastNotifyTime);
+		if (TimeUntilNextNotify > 0.0)
+		{
+			SchedulePendingNotify(TimeUntilNextNotify);
+			return;
+		}
+	}
+
+	NotifyValuesChanged(false);
+}
+
+void UVM_GameplayAttributeGroup::NotifyValuesChanged(bool bSettled)
+{
+	ClearPendingNotify();
+
+	const TArray<float> NewValues = GetValues();
+	if (LastNotifiedValues.Num() != NewValues.Num())
+	{
+		LastNotifiedValues = NewValues;
+		return;
+	}
+
+	bool bHasChanges = false;
+	bool bShouldNotify = bSettled;
+	for (int32 Idx = 0; Idx < NewValues.Num(); ++Idx)
+	{
+		const float Delta = FMath::Abs(NewValues[Idx] - LastNotifiedValues[Idx]);
+		bHasChanges |= Delta > 0.f;
+		bShouldNotify |= Delta >= ValueChangeTolerance && Delta > 0.f;
+	}
+
+	if (!bHasChanges)
+	{
+		return;
+	}
+
+	if (!bShouldNotify)
+	{
+		SchedulePendingNotify(FMath::Max(0.0, SettleDelay - (FPlatformTime::Seconds() - LastSuppressedChangeTime)));
+		return;
+	}
+
+	// GetValues shows all current values, so every changed attribute is notified once any change is large enough
+	LastNotifyTime = FPlatformTime::Seconds();
+	for (int32 Idx = 0; Idx < NewValues.Num(); ++Idx)
+	{
+		const float OldValue = LastNotifiedValues[Idx];
+		if (NewValues[Idx] != OldValue)
+		{
+			LastNotifiedValues[Idx] = NewValues[Idx];
+			OnAttributeValueChangedEvent.Broadcast(Attributes[Idx], NewValues[Idx], OldValue);
+		}
+	}
+	ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(GetValues);
+}
+
+void UVM_GameplayAttributeGroup::SchedulePendingNotify(double Delay)
+{
+	const double NotifyTime = FPlatformTime::Seconds() + Delay;
+	if (PendingNotifyTickerHandle.IsValid())
+	{
+		if (PendingNotifyTime <= NotifyTime)
+		{
+			return;
+		}
+		ClearPendingNotify();
+	}
+
+	PendingNotifyTime = NotifyTime;
+	PendingNotifyTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UVM_GameplayAttributeGroup::HandlePendingNotifyTicker), Delay);
+}
+
+void UVM_GameplayAttributeGroup::ClearPendingNotify()
+{
+	if (PendingNotifyTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingNotifyTickerHandle);
+		PendingNotifyTickerHandle.Reset();
+	}
+}
+
+bool UVM_GameplayAttributeGroup::HandlePendingNotifyTicker(float DeltaTime)
+{
+	// the ticker is removed after returning false, so just forget the handle
+	PendingNotifyTickerHandle.Reset();
+
+	NotifyValuesChanged(FPlatformTime::Seconds() - LastSuppressedChangeTime >= SettleDelay);
+	return false;
+}
@@ -8,6 +8,7 @@
 #include "GameplayAbilitySpecHandle.h"
 #include "GameplayTagContainer.h"
 #include "Engine/DataAsset.h"
+#include "Engine/DataTable.h"
 #include "ExtendedAbilitySet.generated.h"
 
 class UExtendedAbilitySet;
@@ -67,6 +68,13 @@ struct EXTENDEDGAMEPLAYABILITIES_API FExtendedAbilitySetAttributes
 	/** The attribute set to grant. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (AllowAbstract = false))
 	TSubclassOf<UAttributeSet> AttributeSet = nullptr;
+
+	/**
+	 * Optional FExtendedAttributeSetInitRow to initialize the attribute set with when it's spawned.
+	 * Only supported by UExtendedAttributeSet, and cheaper than applying an initialization effect.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (RowType = "/Script/ExtendedGameplayAbilities.ExtendedAttributeSetInitRow"))
+	FDataTableRowHandle InitRow;
 };
 
 
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayEffectSet.h"
+#include "UObject/ObjectKey.h"
 #include "ExtendedAbilitySystemComponent.generated.h"
 
 class UExtendedAbilitySet;
@@ -30,10 +31,17 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Defaults")
 	TArray<TObjectPtr<UExtendedAbilitySet>> StartupAbilitySets;
 
-	/** Mapping that defines additional relationships for how abilities block or cancel other abilities. */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Abilities")
+	/**
+	 * Mapping that defines additional relationships for how abilities block or cancel other abilities.
+	 * Use SetAbilityTagRelationshipMapping to change it at runtime.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetAbilityTagRelationshipMapping, Category = "Abilities")
 	TObjectPtr<UExtendedAbilityTagRelationshipMapping> AbilityTagRelationshipMapping;
 
+	/** Set the ability tag relationship mapping, and notify listeners of the change. */
+	UFUNCTION(BlueprintSetter)
+	void SetAbilityTagRelationshipMapping(UExtendedAbilityTagRelationshipMapping* NewMapping);
+
 	/**
 	 * Create and return an effect spec set.
 	 * The spec set can then be applied using ApplyEffectContainerToSelf on this or another ability system.
@@ -48,6 +56,25 @@ public:
 	UFUNCTION(BlueprintCallable, DisplayName = "ApplyGameplayEffectSpecSetToSelf", Category = "GameplayEffects")
 	TArray<FActiveGameplayEffectHandle> ApplyGameplayEffectSpecSetToSelf(const FGameplayEffectSpecSet& EffectSpecSet);
 
+	/** Return the handles of all active effects that were applied with a source object. */
+	TConstArrayView<FActiveGameplayEffectHandle> GetActiveEffectsBySourceObject(const UObject* SourceObject) const;
+
+	/**
+	 * Remove all active effects that were applied with a source object.
+	 * Uses an index of active effects by source object, instead of querying all active effects.
+	 * @param SourceObject The source object of the effect context, usually a projectile or other gameplay object.
+	 * @param StacksToRemove The number of stacks to remove from each effect, or -1 to remove all stacks.
+	 * @return The number of effects that were removed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GameplayEffects")
+	int32 RemoveActiveEffectsBySourceObject(const UObject* SourceObject, int32 StacksToRemove = -1);
+
+	/**
+	 * Return the handles of all active effects that add a gameplay cue.
+	 * Effects that add a child of the gameplay cue tag are included.
+	 */
+	TConstArrayView<FActiveGameplayEffectHandle> GetActiveEffectsGrantingGameplayCue(const FGameplayTag& GameplayCueTag) const;
+
 	/** Cancel all abilities with the given state tags. */
 	UFUNCTION(BlueprintCallable, Category = "Abilities")
 	void CancelAbilitiesWithState(FGameplayTagContainer WithStateTags, UGameplayAbility* IgnoreAbility);
@@ -58,6 +85,8 @@ public:
 	virtual void ApplyAbilityBlockAndCancelTags(const FGameplayTagContainer& AbilityTags, UGameplayAbility* RequestingAbility,
 	                                            bool bEnableBlockTags, const FGameplayTagContainer& BlockTags,
 	                                            bool bExecuteCancelTags, const FGameplayTagContainer& CancelTags) override;
+	virtual void BlockAbilitiesWithTags(const FGameplayTagContainer& Tags) override;
+	virtual void UnBlockAbilitiesWithTags(const FGameplayTagContainer& Tags) override;
 
 	/** Get any additional required and blocked tags needed for ability activation. */
 	virtual void GetAdditionalActivationTagRequirements(const FGameplayTagContainer& AbilityTags,
@@ -85,4 +114,40 @@ public:
 
 	/** Called when an ability is removed. */
 	FAbilityAddOrRemoveDelegate OnRemoveAbilityEvent;
+
+	/** Called when the ability tag relationship mapping has changed. */
+	FSimpleMulticastDelegate OnAbilityTagRelationshipMappingChangedEvent;
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FAbilityBlockTagsChangedDelegate, const FGameplayTagContainer& /*BlockTags*/);
+
+	/**
+	 * Called after abilities have been blocked or unblocked with tags, either directly
+	 * or by an activating or ending ability, including block tags from the relationship mapping.
+	 */
+	FAbilityBlockTagsChangedDelegate OnAbilityBlockTagsChangedEvent;
+
+	/** Called when a UExtendedAttributeSet of this ability system marks replicated attribute data dirty. */
+	FSimpleMulticastDelegate OnAttributeReplicationDirtiedEvent;
+
+protected:
+	/** Handles of active effects, indexed by the source object of their context. */
+	TMap<TObjectKey<UObject>, TArray<FActiveGameplayEffectHandle>> ActiveEffectsBySourceObject;
+
+	/** The source object each indexed active effect was added with, so it can be removed after the source is destroyed. */
+	TMap<FActiveGameplayEffectHandle, TObjectKey<UObject>> SourceObjectsByActiveEffect;
+
+	/** Handles of active effects, indexed by the gameplay cue tags they add, including parent tags. */
+	TMap<FGameplayTag, TArray<FActiveGameplayEffectHandle>> ActiveEffectsByGameplayCue;
+
+	/** The gameplay cue tags each indexed active effect was added with, see ActiveEffectsByGameplayCue. */
+	TMap<FActiveGameplayEffectHandle, FGameplayTagContainer> GameplayCueTagsByActiveEffect;
+
+	/** Return all gameplay cue tags added by an effect class, including parent tags. Cached per effect class. */
+	static FGameplayTagContainer GetEffectGameplayCueTags(const UGameplayEffect* EffectDef);
+
+	/** Called on server and client when a duration based effect is added. */
+	virtual void OnActiveEffectAdded(UAbilitySystemComponent* AbilitySystem, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle);
+
+	/** Called on server and client when a duration based effect is removed. */
+	virtual void OnActiveEffectRemoved(const FActiveGameplayEffect& ActiveEffect);
 };
@@ -43,15 +43,15 @@ public:
 
 	/** Set a gameplay tag Set By Caller magnitude value for all effects in a set. */
 	UFUNCTION(BlueprintCallable, Meta = (DisplayName = "Assign Tag Set By Caller Magnitude (For Set)"), Category = "Ability|GameplayEffect")
-	static FGameplayEffectSpecSet AssignTagSetByCallerMagnitudeForSet(FGameplayEffectSpecSet EffectSpecSet, FGameplayTag DataTag, float Magnitude);
+	static FGameplayEffectSpecSet AssignTagSetByCallerMagnitudeForSet(const FGameplayEffectSpecSet& EffectSpecSet, FGameplayTag DataTag, float Magnitude);
 
-	/** Add a hit result to the context for all effects in a set. */
+	/** Add a hit result to the shared context of all effects in a set. */
 	UFUNCTION(BlueprintCallable, Meta = (DisplayName = "Add Context Hit Result (For Set)"), Category = "Ability|GameplayEffect")
-	static FGameplayEffectSpecSet AddContextHitResultForSet(FGameplayEffectSpecSet EffectSpecSet, FHitResult HitResult, bool bReset);
+	static FGameplayEffectSpecSet AddContextHitResultForSet(const FGameplayEffectSpecSet& EffectSpecSet, const FHitResult& HitResult, bool bReset);
 
-	/** Set the origin of the context for all effects in a set. */
+	/** Set the origin of the shared context of all effects in a set. */
 	UFUNCTION(BlueprintCallable, Meta = (DisplayName = "Set Context Origin (For Set)"), Category = "Ability|GameplayEffect")
-	static FGameplayEffectSpecSet SetContextOriginForSet(FGameplayEffectSpecSet EffectSpecSet, FVector Origin);
+	static FGameplayEffectSpecSet SetContextOriginForSet(const FGameplayEffectSpecSet& EffectSpecSet, FVector Origin);
 
 	/**
 	 * Apply a gameplay effect spec set to an actor, if it has an ability system.
@@ -81,6 +81,31 @@ public:
 	                                                                         UPARAM(Ref) TArray<AActor*>& AffectedActors,
 	                                                                         bool& bSuccess);
 
+	/**
+	 * Apply a gameplay effect spec set to multiple actors, skipping duplicates and actors without an ability system.
+	 * The source object is updated once for the whole batch.
+	 * @param Actors The actors to apply effects to.
+	 * @param EffectSpecSet The set of gameplay effect specs to apply.
+	 * @param SourceObject The source object, usually projectile or gameplay object applying the effect.
+	 * @return The effect handles of all duration-based applied effects for each affected actor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ability|GameplayEffect")
+	static TArray<FGameplayEffectSpecSetTargetHandles> ApplyEffectSpecSetToActors(const TArray<AActor*>& Actors, const FGameplayEffectSpecSet& EffectSpecSet,
+	                                                                              const UObject* SourceObject);
+
+	/**
+	 * Apply a gameplay effect spec set to multiple actors, but only those that have not already been affected.
+	 * @param Actors The actors to apply effects to.
+	 * @param EffectSpecSet The set of gameplay effect specs to apply.
+	 * @param SourceObject The source object, usually projectile or gameplay object applying the effect.
+	 * @param AffectedActors List of previously affected actors, updated with any newly affected actors.
+	 * @return The effect handles of all duration-based applied effects for each newly affected actor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ability|GameplayEffect")
+	static TArray<FGameplayEffectSpecSetTargetHandles> ApplyEffectSpecSetToActorsOnce(const TArray<AActor*>& Actors, const FGameplayEffectSpecSet& EffectSpecSet,
+	                                                                                  const UObject* SourceObject,
+	                                                                                  UPARAM(Ref) TArray<AActor*>& AffectedActors);
+
 	/**
 	 * Remove any active gameplay effects from an actor that were applied from a source object.
 	 * Also remove the actor from the AffectedActors array, so that ApplyEffectSpecSetToActorOnce
@@ -97,6 +122,15 @@ public:
 	static int32 RemoveEffectsFromActorBySourceObject(AActor* Actor, const UObject* SourceObject,
 	                                                  UPARAM(Ref) TArray<AActor*>& AffectedActors);
 
+	/**
+	 * Remove all effects from multiple actors that were applied by a specific source object.
+	 * See RemoveEffectsFromActorBySourceObject.
+	 * @return The total number of effects that were removed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ability|GameplayEffect")
+	static int32 RemoveEffectsFromActorsBySourceObject(const TArray<AActor*>& Actors, const UObject* SourceObject,
+	                                                   UPARAM(Ref) TArray<AActor*>& AffectedActors);
+
 	/** Return all active effects that are responsible for adding a gameplay cue. */
 	UFUNCTION(BlueprintCallable, Category = "Ability|GameplayEffect")
 	static TArray<FActiveGameplayEffectHandle> GetActiveEffectsGrantingGameplayCue(UAbilitySystemComponent* AbilitySystem, FGameplayTag GameplayCueTag);
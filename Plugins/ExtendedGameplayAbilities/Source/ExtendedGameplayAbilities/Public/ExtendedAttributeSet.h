@@ -4,8 +4,22 @@
 
 #include "CoreMinimal.h"
 #include "AttributeSet.h"
+#include "Engine/DataTable.h"
 #include "ExtendedAttributeSet.generated.h"
 
+class UCurveTable;
+class UExtendedAttributeSet;
+struct FDoRepLifetimeParams;
+struct FExtendedAttributeSetRules;
+
+
+/**
+ * Register a replicated attribute property in GetLifetimeReplicatedProps.
+ * The property is push-based, and is skipped when the attribute set class uses compact replication.
+ */
+#define EXTENDED_ATTRIBUTE_REPLIFETIME(ClassName, PropertyName) \
+	DOREPLIFETIME_WITH_PARAMS_FAST(ClassName, PropertyName, GetAttributeReplicationParams())
+
 
 USTRUCT(BlueprintType)
 struct FExtendedMaxAttributeRules
@@ -20,6 +34,100 @@ struct FExtendedMaxAttributeRules
 };
 
 
+/**
+ * A data table row of initial attribute values, for use with UExtendedAttributeSet::InitFromDataTableRow.
+ * A single row can contain values for attributes of multiple sets, and each set only uses its own.
+ */
+USTRUCT(BlueprintType)
+struct EXTENDEDGAMEPLAYABILITIES_API FExtendedAttributeSetInitRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	/** The initial base and current value of each attribute. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	TMap<FGameplayAttribute, float> Values;
+};
+
+
+/**
+ * The base and current values of all replicated attributes in a set, used for compact replication.
+ * Values are serialized with a bitmask prefix, so that only values that differ from their
+ * defaults (or current values that differ from their base) are sent, optionally quantized.
+ */
+USTRUCT()
+struct EXTENDEDGAMEPLAYABILITIES_API FExtendedCompactAttributeData
+{
+	GENERATED_BODY()
+
+	/** Base values, in the order of FExtendedAttributeSetRules::CompactAttributes. */
+	TArray<float> BaseValues;
+
+	/** Current values, in the order of FExtendedAttributeSetRules::CompactAttributes. */
+	TArray<float> CurrentValues;
+
+	/**
+	 * The owning attribute set class, whose rules define the serialization layout.
+	 * Sent with the values, so that any copy of the data can be deserialized.
+	 */
+	UPROPERTY()
+	TObjectPtr<const UClass> AttributeSetClass;
+
+	/** Return the rules of the owning attribute set class, if any. */
+	const FExtendedAttributeSetRules* GetRules() const;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	/** Compare values after quantization, so that changes smaller than a quantization step are not replicated. */
+	bool operator==(const FExtendedCompactAttributeData& Other) const;
+	bool operator!=(const FExtendedCompactAttributeData& Other) const { return !(*this == Other); }
+};
+
+template <>
+struct TStructOpsTypeTraits<FExtendedCompactAttributeData> : public TStructOpsTypeTraitsBase2<FExtendedCompactAttributeData>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+
+/**
+ * Clamping rules for an attribute set class, built once while constructing or loading the class default object,
+ * and shared by all instances of the class. Rules are not modified after instances of the class have been created.
+ */
+struct EXTENDEDGAMEPLAYABILITIES_API FExtendedAttributeSetRules
+{
+	/** Map of attributes to their max value attributes, for attributed-based clamping. */
+	TMap<FGameplayAttribute, FExtendedMaxAttributeRules> MaxAttributes;
+
+	/** Map of attributes to their min/max values, for non-attribute based clamping. */
+	TMap<FGameplayAttribute, FFloatRange> ValueRanges;
+
+	/** Reverse index of max attributes to the attributes they clamp. */
+	TMap<FGameplayAttribute, TArray<FGameplayAttribute>> DependentsByMaxAttribute;
+
+	/** Quantization step of attributes when using compact replication. */
+	TMap<FGameplayAttribute, float> QuantizationSteps;
+
+	/** Replicate all attributes in a single FExtendedCompactAttributeData property. */
+	bool bCompactReplication = false;
+
+	/** The attributes replicated in compact mode, in serialization order. */
+	TArray<FGameplayAttribute> CompactAttributes;
+
+	/** The quantization step of each compact attribute, or 0 for full precision. */
+	TArray<float> CompactQuantizationSteps;
+
+	/** The default value of each compact attribute, which doesn't need to be sent. */
+	TArray<float> CompactDefaultValues;
+
+	/** The maximum number of attributes supported by compact replication. */
+	static constexpr int32 MaxCompactAttributes = 32;
+};
+
+
 /**
  * AttributeSet with some built-in support for clamping and proportional value changes.
  */
@@ -29,28 +137,79 @@ class EXTENDEDGAMEPLAYABILITIES_API UExtendedAttributeSet : public UAttributeSet
 	GENERATED_BODY()
 
 public:
-	/** Map of attributes to their max value attributes, for attributed-based clamping. */
-	UPROPERTY(EditAnywhere)
-	TMap<FGameplayAttribute, FExtendedMaxAttributeRules> MaxAttributesMap;
-
-	/** Map of attributes to their min/max values, for non-attribute based clamping. */
-	UPROPERTY(EditAnywhere)
-	TMap<FGameplayAttribute, FFloatRange> MinMaxValuesMap;
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
 
 	/**
 	 * Set an attribute to act as the maximum value for another attribute.
+	 * Should be called from the constructor. Rules are stored per class when constructing the
+	 * class default object, and calls on other instances are ignored.
 	 * @param Attribute The attribute to clamp.
 	 * @param MaxAttribute The attribute representing the maximum value.
 	 * @param bProportional When the max attribute changes, adjust the base attribute proportionally.
 	 */
 	void SetMaxAttribute(const FGameplayAttribute& Attribute, const FGameplayAttribute& MaxAttribute, bool bProportional = false);
 
-	/** Set the minimum and maximum values for an attribute. */
+	/**
+	 * Set the minimum and maximum values for an attribute.
+	 * Should be called from the constructor, see SetMaxAttribute.
+	 */
 	void SetAttributeValueRange(const FGameplayAttribute& Attribute, float Min, float Max);
 
+	/**
+	 * Replicate all attributes of this class in a single push-model property, instead of one property per attribute.
+	 * Should be called from the constructor, see SetMaxAttribute. Replicated attributes must be registered
+	 * using EXTENDED_ATTRIBUTE_REPLIFETIME, and a set can contain at most 32 replicated attributes.
+	 */
+	void SetUseCompactReplication(bool bEnabled);
+
+	/**
+	 * Set the precision of an attribute when using compact replication, e.g. 0.1 to replicate HP to one decimal place.
+	 * Should be called from the constructor, see SetMaxAttribute.
+	 */
+	void SetAttributeQuantization(const FGameplayAttribute& Attribute, float Step);
+
+	/** Return true if this attribute set class uses compact replication. */
+	bool IsUsingCompactReplication() const;
+
+	/**
+	 * Update the compact replicated data from all current attribute values.
+	 * Only needed after attribute values are changed directly instead of through the ability system.
+	 */
+	void RefreshCompactAttributeData();
+
+	/** Return the clamping rules for this attribute set's class, if any. */
+	const FExtendedAttributeSetRules* GetRules() const { return Rules; }
+
+	/**
+	 * Set the base and current values of many attributes of this set in one pass, without applying effects.
+	 * Values are clamped, then replication and OnAttributesInitializedEvent are triggered once.
+	 * Intended for initializing newly spawned attribute sets, since active modifiers are not taken into account.
+	 * Attributes that don't belong to this set are ignored.
+	 * @return The number of attributes that were set.
+	 */
+	int32 InitAttributeValues(const TMap<FGameplayAttribute, float>& Values);
+
+	/** Initialize attribute values from an FExtendedAttributeSetInitRow data table row. */
+	UFUNCTION(BlueprintCallable, Category = "Attributes")
+	int32 InitFromDataTableRow(const FDataTableRowHandle& RowHandle);
+
+	/**
+	 * Initialize attribute values from a curve table, evaluated at a level.
+	 * Each attribute uses the row named '{RowPrefix}.{AttributeName}', or just the attribute name if RowPrefix is none.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Attributes")
+	int32 InitFromCurveTable(const UCurveTable* CurveTable, FName RowPrefix, float Level = 1.f);
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FAttributesInitializedDelegate, UExtendedAttributeSet* /*AttributeSet*/);
+
+	/** Called once after attribute values are initialized in bulk. */
+	FAttributesInitializedDelegate OnAttributesInitializedEvent;
+
 	virtual void PreAttributeBaseChange(const FGameplayAttribute& Attribute, float& NewValue) const override;
 	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
 	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+	virtual void PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const override;
 
 	/** Perform clamping specific to this attribute set. For use when either base or current value is changing. */
 	virtual void ClampAttribute(const FGameplayAttribute& Attribute, float& NewValue) const;
@@ -63,4 +222,50 @@ public:
 
 	/** Set the default base and current value of an attribute. */
 	static void InitAttribute(FGameplayAttributeData& AttributeData, float Value);
+
+	/** Return the clamping rules for an attribute set class or its nearest super class, if any. */
+	static const FExtendedAttributeSetRules* FindRulesForClass(const UClass* AttributeSetClass);
+
+protected:
+	/** The shared clamping rules of this class, cached when initialized. */
+	const FExtendedAttributeSetRules* Rules = nullptr;
+
+	/** Deprecated per-instance max attribute rules, folded into the class rules when the class default object is loaded. */
+	UPROPERTY()
+	TMap<FGameplayAttribute, FExtendedMaxAttributeRules> MaxAttributesMap_DEPRECATED;
+
+	/** Deprecated per-instance value ranges, folded into the class rules when the class default object is loaded. */
+	UPROPERTY()
+	TMap<FGameplayAttribute, FFloatRange> MinMaxValuesMap_DEPRECATED;
+
+	/** All replicated attribute values, when using compact replication. */
+	UPROPERTY(ReplicatedUsing = OnRep_CompactAttributeData)
+	FExtendedCompactAttributeData CompactAttributeData;
+
+	UFUNCTION()
+	virtual void OnRep_CompactAttributeData(const FExtendedCompactAttributeData& OldData);
+
+	/** Return the replication params to use for attribute properties, see EXTENDED_ATTRIBUTE_REPLIFETIME. */
+	FDoRepLifetimeParams GetAttributeReplicationParams() const;
+
+	/**
+	 * Mark an attribute property dirty for push-model replication.
+	 * Called automatically when values change through the ability system.
+	 */
+	void MarkAttributeDirty(const FGameplayAttribute& Attribute);
+
+	/** Notify the owning ability system that replicated attribute data was marked dirty. */
+	void NotifyAttributeReplicationDirtied() const;
+
+	/** Update the compact replicated data for an attribute, if it has authority. */
+	void UpdateCompactAttribute(const FGameplayAttribute& Attribute);
+
+	/** Copy an attribute's values into the compact data, returning true if it changed after quantization. */
+	bool CopyToCompactAttributeData(int32 Index);
+
+	/** Modify the rules for this class while holding the rules lock. Does nothing unless called on the class default object. */
+	void ModifyClassRules(TFunctionRef<void(FExtendedAttributeSetRules& ClassRules)> Func);
+
+	/** Gather the replicated attributes and their defaults for compact replication. Called on the class default object. */
+	void BuildCompactAttributes(FExtendedAttributeSetRules& ClassRules) const;
 };
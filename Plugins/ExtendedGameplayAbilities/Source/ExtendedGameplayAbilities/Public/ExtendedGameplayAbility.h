@@ -127,10 +127,20 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Ability|GameplayEffect")
 	FGameplayEffectSet GetEffectSet(FGameplayTag Tag) const;
 
-	/** Create a new gameplay effect spec set. */
+	/**
+	 * Create a new gameplay effect spec set.
+	 * All specs share one context, and are made with MakeOutgoingGameplayEffectSpecWithContext.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Ability|GameplayEffect")
 	FGameplayEffectSpecSet MakeEffectSpecSet(const FGameplayEffectSet& EffectSet, int32 OverrideGameplayLevel = -1);
 
+	/**
+	 * Create an outgoing effect spec using an existing context, applying ability tags and set-by-caller magnitudes
+	 * the same as MakeOutgoingGameplayEffectSpec. Override this to customize specs created for effect spec sets.
+	 */
+	virtual FGameplayEffectSpecHandle MakeOutgoingGameplayEffectSpecWithContext(TSubclassOf<UGameplayEffect> GameplayEffectClass, float Level,
+	                                                                            const FGameplayEffectContextHandle& Context) const;
+
 	/** Create a new gameplay effect spec set using a set from the EffectSetMap by tag. */
 	UFUNCTION(BlueprintPure, Meta = (AdvancedDisplay = "1"), Category = "Ability|GameplayEffect")
 	FGameplayEffectSpecSet MakeEffectSpecSetByTag(FGameplayTag Tag, int32 OverrideGameplayLevel = -1);
@@ -188,6 +198,12 @@ public:
 	UFUNCTION(BlueprintPure)
 	const FGameplayTagContainer& GetAbilityStateTags() const { return AbilityStateTags; }
 
+	/** Return the tags required on the owning ability system to activate this ability. */
+	const FGameplayTagContainer& GetActivationRequiredTags() const { return ActivationRequiredTags; }
+
+	/** Return the tags that prevent activation of this ability when present on the owning ability system. */
+	const FGameplayTagContainer& GetActivationBlockedTags() const { return ActivationBlockedTags; }
+
 	/**
 	 * Add an input mapping context, only on the locally controlled client.
 	 * Will be removed automatically when the ability deactivates, if not removed manually.
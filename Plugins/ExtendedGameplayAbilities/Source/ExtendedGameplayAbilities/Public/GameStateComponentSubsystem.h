@@ -0,0 +1,54 @@
+﻿// Copyright Bohdon Sayre, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameStateComponentSubsystem.generated.h"
+
+class UActorComponent;
+
+
+/**
+ * Provides fast access to components of the game state, which are otherwise found using FindComponentByClass.
+ * Components can register themselves during BeginPlay, and any other game state components
+ * are found and cached the first time they are requested.
+ */
+UCLASS()
+class EXTENDEDGAMEPLAYABILITIES_API UGameStateComponentSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Return the subsystem for a world context object. */
+	static UGameStateComponentSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Register a component so it can be found by its class or any of its super classes. */
+	void RegisterComponent(UActorComponent* Component);
+
+	/** Unregister a component, e.g. during EndPlay. */
+	void UnregisterComponent(UActorComponent* Component);
+
+	/** Return a game state component by class. */
+	UActorComponent* FindComponent(const UClass* ComponentClass) const;
+
+	template <class T>
+	T* FindComponent() const
+	{
+		return static_cast<T*>(FindComponent(T::StaticClass()));
+	}
+
+	/** Return a game state component by class, using a world context object. */
+	template <class T>
+	static T* FindComponent(const UObject* WorldContextObject)
+	{
+		const UGameStateComponentSubsystem* Subsystem = Get(WorldContextObject);
+		return Subsystem ? Subsystem->FindComponent<T>() : nullptr;
+	}
+
+	virtual void Deinitialize() override;
+
+protected:
+	/** Components by their class and super classes. */
+	mutable TMap<TObjectKey<UClass>, TWeakObjectPtr<UActorComponent>> ComponentsByClass;
+};
@@ -8,6 +8,7 @@
 #include "ScalableFloat.h"
 #include "GameplayEffectSet.generated.h"
 
+class AActor;
 class UGameplayEffect;
 
 
@@ -56,6 +57,37 @@ struct EXTENDEDGAMEPLAYABILITIES_API FGameplayEffectSpecSet
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability|GameplayEffectSets")
 	TArray<FGameplayEffectSpecHandle> EffectSpecs;
 
+	/**
+	 * The effect context shared by all specs created for this set.
+	 * Changes to the context such as adding a hit result only need to be made once.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Ability|GameplayEffectSets")
+	FGameplayEffectContextHandle Context;
+
 	/** Return true if set has no valid effect specs. */
 	bool IsEmpty() const;
+
+	/**
+	 * Call a function once for the shared context, and once for each spec that doesn't use the shared context.
+	 * Modifying a context is a lasting change for all specs that reference it.
+	 */
+	void ForEachContext(TFunctionRef<void(FGameplayEffectContextHandle& EffectContext)> Func) const;
+};
+
+
+/**
+ * The active effect handles that resulted from applying a gameplay effect spec set to a target.
+ */
+USTRUCT(BlueprintType)
+struct EXTENDEDGAMEPLAYABILITIES_API FGameplayEffectSpecSetTargetHandles
+{
+	GENERATED_BODY()
+
+	/** The actor the effects were applied to. */
+	UPROPERTY(BlueprintReadOnly, Category = "Ability|GameplayEffectSets")
+	TObjectPtr<AActor> Actor = nullptr;
+
+	/** The handles of all duration-based applied effects. */
+	UPROPERTY(BlueprintReadOnly, Category = "Ability|GameplayEffectSets")
+	TArray<FActiveGameplayEffectHandle> EffectHandles;
 };
@@ -53,6 +53,9 @@ public:
 
 	virtual void OnEndPhase(const UGamePhaseAbility* Ability, const FGameplayAbilitySpecHandle AbilityHandle);
 
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 protected:
 	/** Entry for storing data about an active phase ability. */
 	struct FActiveGamePhaseEntry
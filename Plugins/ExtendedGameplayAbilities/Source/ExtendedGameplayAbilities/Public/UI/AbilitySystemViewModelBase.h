@@ -4,17 +4,31 @@
 
 #include "CoreMinimal.h"
 #include "MVVMViewModelBase.h"
+#include "Containers/Ticker.h"
 #include "Templates/SubclassOf.h"
 #include "AbilitySystemViewModelBase.generated.h"
 
 class UAbilitySystemComponent;
 
 
+/**
+ * Broadcast a field value change, or defer it until the next flush if the view model has deferred field notifications enabled.
+ * Use in place of UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED for changes that originate from gameplay callbacks.
+ */
+#define ABILITY_VM_BROADCAST_FIELD_VALUE_CHANGED(MemberName) BroadcastOrDeferFieldValueChanged(ThisClass::FFieldNotificationClassDescriptor::MemberName)
+
+
 /**
  * Base class for a view model that uses a UAbilitySystemComponent.
  *
  * Subclasses should implement PreSystemChange and PostSystemChange to unbind/bind relevant events,
  * as well as call those methods before and after changing other properties that affect the bindings.
+ *
+ * Field notifications can optionally be deferred, so that many changes in one frame are coalesced
+ * into a single broadcast per field, flushed once per frame or at a fixed interval.
+ *
+ * Updates can also be suspended, e.g. while a widget is hidden or far away, which unbinds all events
+ * until resumed. Subclasses must not bind events in PostSystemChange while updates are suspended.
  */
 UCLASS(BlueprintType)
 class EXTENDEDGAMEPLAYABILITIES_API UAbilitySystemViewModelBase : public UMVVMViewModelBase
@@ -33,10 +47,42 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
 	TSubclassOf<UAbilitySystemComponent> RequireAbilitySystemClass;
 
+	/** If true, record field value changes and broadcast them together on the next flush, instead of immediately. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Setter)
+	bool bDeferFieldNotifications = false;
+
+	/** The minimum time between flushes of deferred field notifications. If 0, flush once per frame. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Setter, meta = (ClampMin = "0", Units = "s"))
+	float DeferredNotifyInterval = 0.f;
+
 public:
+	virtual void BeginDestroy() override;
+
+	UFUNCTION(BlueprintSetter)
+	void SetDeferFieldNotifications(bool bNewDeferFieldNotifications);
+
+	UFUNCTION(BlueprintSetter)
+	void SetDeferredNotifyInterval(float NewDeferredNotifyInterval);
+
+	/** Immediately broadcast all deferred field value changes. */
+	UFUNCTION(BlueprintCallable)
+	void FlushDeferredFieldNotifications();
+
 	UFUNCTION(BlueprintCallable)
 	virtual void SetAbilitySystem(UAbilitySystemComponent* NewAbilitySystem);
 
+	/**
+	 * Suspend or resume updates from the ability system.
+	 * While suspended, events are unbound and values may be stale or empty.
+	 * When resumed, events are rebound and all fields are broadcast to resync any bindings.
+	 */
+	UFUNCTION(BlueprintCallable)
+	void SetUpdatesSuspended(bool bNewUpdatesSuspended);
+
+	/** Are updates from the ability system currently suspended? */
+	UFUNCTION(BlueprintPure)
+	bool AreUpdatesSuspended() const { return bUpdatesSuspended; }
+
 	UFUNCTION(BlueprintPure, FieldNotify)
 	UAbilitySystemComponent* GetAbilitySystem() const { return AbilitySystem.Get(); }
 
@@ -59,4 +105,23 @@ protected:
 	 * Used to bind events and broadcast field value changes.
 	 */
 	virtual void PostSystemChange();
+
+	/** Called after updates have been suspended or resumed. */
+	virtual void OnUpdatesSuspendedChanged();
+
+	/** Broadcast a field value change, or record it to be flushed later if deferring notifications. */
+	void BroadcastOrDeferFieldValueChanged(UE::FieldNotification::FFieldId FieldId);
+
+private:
+	bool bUpdatesSuspended = false;
+
+	/** Fields with deferred value changes, in the order they were changed. */
+	TArray<UE::FieldNotification::FFieldId> DeferredFieldIds;
+
+	/** Bits for each field index in DeferredFieldIds, to avoid duplicates. */
+	TBitArray<> DeferredFieldBits;
+
+	FTSTicker::FDelegateHandle DeferredFlushTickerHandle;
+
+	bool HandleDeferredFlushTicker(float DeltaTime);
 };
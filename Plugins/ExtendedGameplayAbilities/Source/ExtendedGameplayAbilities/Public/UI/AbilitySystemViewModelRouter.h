@@ -0,0 +1,137 @@
+﻿// Copyright Bohdon Sayre, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActiveGameplayEffectHandle.h"
+#include "AttributeSet.h"
+#include "GameplayAbilitySpecHandle.h"
+#include "GameplayTagContainer.h"
+#include "UObject/Object.h"
+#include "UObject/ObjectKey.h"
+#include "AbilitySystemViewModelRouter.generated.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+class UVM_GameplayAbility;
+struct FAbilityEndedData;
+struct FActiveGameplayEffect;
+struct FGameplayEffectSpec;
+struct FOnAttributeChangeData;
+
+
+/**
+ * Binds once to the ability system events that ability view models need, and dispatches each
+ * event only to the view models interested in that ability, tag, or attribute, using lookup tables.
+ * A single router is shared by all view models of the same ability system.
+ *
+ * Also tracks whether each ability's asset tags are blocked. Extended ability systems broadcast the
+ * tags that were blocked or unblocked, otherwise all abilities are checked when any ability activates or ends.
+ */
+UCLASS(Transient)
+class EXTENDEDGAMEPLAYABILITIES_API UAbilitySystemViewModelRouter : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Return the router for an ability system, creating it if needed. */
+	static UAbilitySystemViewModelRouter* GetOrCreate(UAbilitySystemComponent* InAbilitySystem);
+
+	virtual void BeginDestroy() override;
+
+	UAbilitySystemComponent* GetAbilitySystem() const { return AbilitySystem.Get(); }
+
+	/** Register an ability view model, using its current spec handle, ability class, cooldown tags, and cost attributes. */
+	void RegisterAbilityViewModel(UVM_GameplayAbility* ViewModel);
+
+	void UnregisterAbilityViewModel(UVM_GameplayAbility* ViewModel);
+
+	/** Update the active cooldown effect of a registered view model, to be notified when it is removed. */
+	void UpdateCooldownEffect(UVM_GameplayAbility* ViewModel, FActiveGameplayEffectHandle CooldownEffectHandle);
+
+protected:
+	using FListenerArray = TArray<TWeakObjectPtr<UVM_GameplayAbility>>;
+
+	/** The keys a view model was registered with, used to remove it from the lookup tables. */
+	struct FAbilityRegistration
+	{
+		FGameplayAbilitySpecHandle AbilitySpecHandle;
+		TObjectKey<UClass> AbilityClass;
+		FGameplayTagContainer CooldownTags;
+		FGameplayTagContainer ActivationTags;
+		TArray<FGameplayAttribute> CostAttributes;
+		FActiveGameplayEffectHandle CooldownEffectHandle;
+
+		/** The ability's asset tags, used to check if it is blocked. */
+		FGameplayTagContainer AbilityTags;
+
+		/** Whether the ability tags were blocked when last checked. */
+		bool bIsBlocked = false;
+
+		/** Whether activation relevant tags are unknown, and any tag change should invalidate CanActivate. */
+		bool bListensToAllTags = false;
+	};
+
+	/** The ability system being routed. */
+	TWeakObjectPtr<UAbilitySystemComponent> AbilitySystem;
+
+	/** Key of the ability system in the router map, valid even after the ability system is destroyed. */
+	TObjectKey<UAbilitySystemComponent> AbilitySystemKey;
+
+	TMap<TObjectKey<UVM_GameplayAbility>, FAbilityRegistration> Registrations;
+
+	TMap<TObjectKey<UClass>, FListenerArray> ListenersByAbilityClass;
+	TMap<FGameplayAbilitySpecHandle, FListenerArray> ListenersBySpecHandle;
+	TMap<FGameplayTag, FListenerArray> ListenersByCooldownTag;
+	TMap<FGameplayTag, FListenerArray> ListenersByActivationTag;
+	TMap<FGameplayAttribute, FListenerArray> ListenersByCostAttribute;
+	TMap<FActiveGameplayEffectHandle, FListenerArray> ListenersByCooldownEffect;
+
+	/** Handles of the bound cooldown tag events, so they can be unregistered without adding tag events to the ability system. */
+	TMap<FGameplayTag, FDelegateHandle> CooldownTagEventHandles;
+
+	/** View models by their ability's asset tags and parent tags, which are blocked by any of those tags. */
+	TMap<FGameplayTag, FListenerArray> ListenersByAbilityTag;
+
+	/** Whether the ability system broadcasts block tag changes, see UExtendedAbilitySystemComponent::OnAbilityBlockTagsChangedEvent. */
+	bool bHasAbilityBlockTagEvents = false;
+
+	/** View models of abilities whose activation relevant tags are unknown. */
+	FListenerArray AllTagListeners;
+
+	void BindToAbilitySystem(UAbilitySystemComponent* InAbilitySystem);
+	void UnbindFromAbilitySystem();
+
+	void AddCooldownTagListener(const FGameplayTag& CooldownTag, UVM_GameplayAbility* ViewModel);
+	void RemoveCooldownTagListener(const FGameplayTag& CooldownTag, UVM_GameplayAbility* ViewModel);
+	void AddCostAttributeListener(const FGameplayAttribute& Attribute, UVM_GameplayAbility* ViewModel);
+	void RemoveCostAttributeListener(const FGameplayAttribute& Attribute, UVM_GameplayAbility* ViewModel);
+
+	/** Remove a view model from a lookup table entry, removing the entry if it becomes empty. */
+	template <typename KeyType>
+	static void RemoveListener(TMap<KeyType, FListenerArray>& ListenerMap, const KeyType& Key, UVM_GameplayAbility* ViewModel);
+
+	/** Invalidate CanActivate for any of the view models whose ability tags became blocked or unblocked. */
+	void UpdateBlockedAbilities(TConstArrayView<TWeakObjectPtr<UVM_GameplayAbility>> ViewModels);
+
+	/** Update blocked abilities for all registered view models. */
+	void UpdateAllBlockedAbilities();
+
+	/** Call a function on each registered view model in a listener array, safe against registration changes during dispatch. */
+	template <typename FuncType>
+	void Dispatch(const FListenerArray* Listeners, FuncType&& Func) const;
+
+	void OnAbilityActivated(UGameplayAbility* GameplayAbility);
+	void OnAbilityEnded(const FAbilityEndedData& AbilityEndedData);
+	void OnActiveGameplayEffectAdded(UAbilitySystemComponent* AbilitySystemComponent,
+	                                 const FGameplayEffectSpec& GameplayEffectSpec,
+	                                 FActiveGameplayEffectHandle ActiveGameplayEffectHandle);
+	void OnAnyGameplayEffectRemoved(const FActiveGameplayEffect& ActiveGameplayEffect);
+	void OnCooldownTagChanged(FGameplayTag GameplayTag, int32 NewCount);
+	void OnAnyTagChanged(FGameplayTag GameplayTag, int32 NewCount);
+	void OnCostAttributeChanged(const FOnAttributeChangeData& AttributeChangeData);
+	void OnAbilityBlockTagsChanged(const FGameplayTagContainer& BlockTags);
+
+	/** Re-register all view models, since their activation relevant tags may have changed. */
+	void OnAbilityTagRelationshipMappingChanged();
+};
@@ -37,10 +37,17 @@ public:
 	UFUNCTION(BlueprintPure, FieldNotify)
 	TArray<FGameplayAbilitySpecHandle> GetAbilitySpecHandles() const;
 
-	/** Return an array of view models for each activatable ability. */
+	/**
+	 * Return an array of view models for each activatable ability.
+	 * View models are persistent, and the same instance is returned for an ability for as long as it remains granted.
+	 */
 	UFUNCTION(BlueprintPure, FieldNotify)
 	TArray<UVM_GameplayAbility*> GetAbilityViewModels() const;
 
+	/** Return the view model for an ability spec, if it is included in this list. */
+	UFUNCTION(BlueprintPure)
+	UVM_GameplayAbility* FindAbilityViewModel(FGameplayAbilitySpecHandle AbilitySpecHandle) const;
+
 	/** Return the first ability spec handle that matches tag requirements. */
 	UFUNCTION(BlueprintPure)
 	FGameplayAbilitySpecHandle FindAbilityMatchingTags(FGameplayTagContainer MatchingTags, FGameplayTagContainer IgnoreTags) const;
@@ -53,15 +60,69 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FAbilitiesChangedDynDelegate OnAbilitiesChangedEvent;
 
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAbilityViewModelChangedDynDelegate, UVM_GameplayAbility*, AbilityViewModel);
+
+	/** Called when a view model is added for a newly included ability. */
+	UPROPERTY(BlueprintAssignable)
+	FAbilityViewModelChangedDynDelegate OnAbilityViewModelAddedEvent;
+
+	/** Called when a view model is retired, because its ability was removed or no longer matches. */
+	UPROPERTY(BlueprintAssignable)
+	FAbilityViewModelChangedDynDelegate OnAbilityViewModelRemovedEvent;
+
 protected:
+	/** View models for all included abilities, in the order they were added. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UVM_GameplayAbility>> AbilityViewModels;
+
+	/** Map of ability spec handles to their view model, for fast lookup. */
+	TMap<FGameplayAbilitySpecHandle, TObjectPtr<UVM_GameplayAbility>> AbilityViewModelsByHandle;
+
 	/**
 	 * Temporary handle to the ability being removed in OnRemoveAbility, since it won't have
 	 * been removed from ActivatableAbilities yet, and needs to be ignored explicitly.
 	 */
 	FGameplayAbilitySpecHandle AbilityBeingRemoved;
 
+	/** Cached combined tags of an ability spec, and whether they match the tag query. */
+	struct FAbilityTagCacheEntry
+	{
+		/** The ability the tags were gathered from. */
+		TObjectKey<UGameplayAbility> Ability;
+
+		/** Snapshot of the spec's dynamic tags, used to detect changes. */
+		FGameplayTagContainer DynamicTags;
+
+		/** The ability's asset tags combined with the spec's dynamic tags. */
+		FGameplayTagContainer AbilityTags;
+
+		/** Memoized result of matching AbilityTags against AbilityTagQuery. */
+		TOptional<bool> bMatchesQuery;
+	};
+
+	/** Combined ability tags for each spec, validated against the spec on each read. */
+	mutable TMap<FGameplayAbilitySpecHandle, FAbilityTagCacheEntry> AbilityTagCache;
+
+	/** Return the cached tag entry for an ability spec, rebuilding it if the ability or its dynamic tags changed. */
+	FAbilityTagCacheEntry& GetAbilityTagCacheEntry(const FGameplayAbilitySpec& AbilitySpec) const;
+
+	/** Return true if an ability spec matches the tag query, using the memoized result when possible. */
+	bool MatchesAbilityTagQuery(const FGameplayAbilitySpec& AbilitySpec) const;
+
 	virtual void PreSystemChange() override;
 	virtual void PostSystemChange() override;
+	virtual void OnUpdatesSuspendedChanged() override;
 	virtual void OnGiveAbility(FGameplayAbilitySpec& GameplayAbilitySpec);
 	virtual void OnRemoveAbility(FGameplayAbilitySpec& GameplayAbilitySpec);
+
+	/** Diff the current view models against the activatable abilities, adding and retiring view models as needed. */
+	void RefreshAbilityViewModels();
+
+	UVM_GameplayAbility* AddAbilityViewModel(FGameplayAbilitySpecHandle AbilitySpecHandle);
+
+	/** Retire the view model for an ability, unbinding it from the ability system. */
+	void RemoveAbilityViewModel(FGameplayAbilitySpecHandle AbilitySpecHandle);
+
+	/** Broadcast field changes and events after the list of abilities has changed. */
+	void BroadcastAbilitiesChanged();
 };
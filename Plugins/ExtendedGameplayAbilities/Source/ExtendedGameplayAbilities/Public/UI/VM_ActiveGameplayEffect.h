@@ -10,6 +10,7 @@
 #include "VM_ActiveGameplayEffect.generated.h"
 
 class UGameplayEffectUIData;
+class UWorld;
 
 
 /**
@@ -45,6 +46,17 @@ public:
 	UFUNCTION(BlueprintSetter)
 	void SetUIDataClass(TSubclassOf<UGameplayEffectUIData> NewUIDataClass);
 
+	/**
+	 * Suspend or resume updates from the active effect.
+	 * While suspended, effect events are unbound. When resumed, they are rebound and all fields are broadcast.
+	 */
+	UFUNCTION(BlueprintCallable)
+	void SetUpdatesSuspended(bool bNewUpdatesSuspended);
+
+	/** Are updates from the active effect currently suspended? */
+	UFUNCTION(BlueprintPure)
+	bool AreUpdatesSuspended() const { return bUpdatesSuspended; }
+
 	/** Return UI data for the effect. */
 	UFUNCTION(BlueprintPure, FieldNotify)
 	const UGameplayEffectUIData* GetUIData() const;
@@ -53,13 +65,17 @@ public:
 	int32 GetStackCount() const;
 
 	UFUNCTION(BlueprintPure, FieldNotify)
-	float GetStartTime() const;
+	float GetStartTime() const { return CachedStartTime; }
 
+	/**
+	 * Return the world time when the effect will end, or -1 if it has an infinite duration.
+	 * Only changes when the effect's timing changes, so widgets can bind to it and animate without polling.
+	 */
 	UFUNCTION(BlueprintPure, FieldNotify)
 	float GetEndTime() const;
 
 	UFUNCTION(BlueprintPure, FieldNotify)
-	float GetDuration() const;
+	float GetDuration() const { return CachedDuration; }
 
 	UFUNCTION(BlueprintPure, FieldNotify)
 	bool IsInhibited() const;
@@ -75,6 +91,29 @@ public:
 	FActiveGameplayEffectEvents* GetActiveEffectEventSet() const;
 
 protected:
+	/** The cached start time of the effect, updated when its timing changes. */
+	float CachedStartTime = 0.f;
+
+	/** The cached duration of the effect, updated when its timing changes. */
+	float CachedDuration = 0.f;
+
+	/** The world of the owning ability system, used to compute remaining time. */
+	TWeakObjectPtr<UWorld> CachedWorld;
+
+	bool bUpdatesSuspended = false;
+
+	void BindToEffectEvents();
+	void UnbindFromEffectEvents();
+
+	/** Broadcast all effect fields, after the effect handle changed or updates were resumed. */
+	void BroadcastEffectFields();
+
+	/** Update the cached start time and duration from the active effect. */
+	void UpdateCachedTiming();
+
+	/** Return the current world time, for computing remaining time. */
+	float GetWorldTime() const;
+
 	void OnEffectRemoved(const FGameplayEffectRemovalInfo& InRemovalInfo);
 
 	void OnEffectStackChanged(FActiveGameplayEffectHandle Handle, int32 NewStackCount, int32 OldStackCount);
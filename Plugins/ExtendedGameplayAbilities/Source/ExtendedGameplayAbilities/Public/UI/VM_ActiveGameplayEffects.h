@@ -35,17 +35,71 @@ public:
 	UFUNCTION(BlueprintSetter)
 	void SetRequiredUIDataClass(TSubclassOf<UGameplayEffectUIData> NewRequireUIDataClass);
 
-	/** Return all active gameplay effects. */
+	/** Return all included active gameplay effects. The list is maintained as effects are added and removed. */
 	UFUNCTION(BlueprintPure, FieldNotify)
 	TArray<FActiveGameplayEffectHandle> GetActiveEffects() const;
 
-	/** Return a list of view models for all active gameplay effects. */
+	/**
+	 * Return a list of view models for all active gameplay effects.
+	 * View models are persistent, and the same instance is returned for an effect for as long as it remains active.
+	 */
 	UFUNCTION(BlueprintPure, FieldNotify)
 	TArray<UVM_ActiveGameplayEffect*> GetActiveEffectViewModels() const;
 
+	/** Return the view model for an active gameplay effect, if it is included in this list. */
+	UFUNCTION(BlueprintPure)
+	UVM_ActiveGameplayEffect* FindEffectViewModel(FActiveGameplayEffectHandle EffectHandle) const;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FEffectViewModelChangedDynDelegate, UVM_ActiveGameplayEffect*, EffectViewModel);
+
+	/** Called when a view model is added for a newly active effect. */
+	UPROPERTY(BlueprintAssignable)
+	FEffectViewModelChangedDynDelegate OnEffectViewModelAddedEvent;
+
+	/** Called when a view model is retired, because its effect was removed or no longer matches. */
+	UPROPERTY(BlueprintAssignable)
+	FEffectViewModelChangedDynDelegate OnEffectViewModelRemovedEvent;
+
 protected:
+	/** View models for all included active effects, in the order they were added. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UVM_ActiveGameplayEffect>> EffectViewModels;
+
+	/** Map of active effect handles to their view model, for fast lookup. */
+	TMap<FActiveGameplayEffectHandle, TObjectPtr<UVM_ActiveGameplayEffect>> EffectViewModelsByHandle;
+
+	/** Handles of all included active effects, in the same order as EffectViewModels. */
+	TArray<FActiveGameplayEffectHandle> ActiveEffectHandles;
+
+	/** Cached results of whether each gameplay effect definition has the RequiredUIDataClass component. */
+	mutable TMap<TObjectKey<UGameplayEffect>, bool> HasRequiredUIDataCache;
+
 	virtual void PreSystemChange() override;
 	virtual void PostSystemChange() override;
+	virtual void OnUpdatesSuspendedChanged() override;
+
+	/** Return true if an active effect should be included in this list. */
+	virtual bool ShouldIncludeEffect(const FActiveGameplayEffect& ActiveEffect) const;
+
+	/** Return true if a gameplay effect definition has the RequiredUIDataClass component, using a cache. */
+	bool HasRequiredUIData(const UGameplayEffect* EffectDef) const;
+
+	/** Search the ability system for all active effects that should be included. */
+	TArray<FActiveGameplayEffectHandle> FindIncludedEffects() const;
+
+	/** Diff the current view models against the active effects, adding and retiring view models as needed. */
+	void RefreshEffectViewModels();
+
+	UVM_ActiveGameplayEffect* AddEffectViewModel(FActiveGameplayEffectHandle EffectHandle);
+
+	/**
+	 * Retire the view model for an effect.
+	 * @param bEffectRemoved If true, the effect itself was removed, otherwise it's just no longer included.
+	 */
+	void RemoveEffectViewModel(FActiveGameplayEffectHandle EffectHandle, bool bEffectRemoved);
+
+	/** Broadcast field changes after the list of effects has changed. */
+	void BroadcastEffectsChanged();
 
 	virtual void OnActiveGameplayEffectAdded(UAbilitySystemComponent* AbilitySystemComponent,
 	                                         const FGameplayEffectSpec& GameplayEffectSpec,
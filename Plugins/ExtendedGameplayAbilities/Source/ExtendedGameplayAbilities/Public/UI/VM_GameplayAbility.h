@@ -10,6 +10,7 @@
 #include "VM_GameplayAbility.generated.h"
 
 class UAbilitySystemComponent;
+class UAbilitySystemViewModelRouter;
 class UGameplayAbility;
 struct FGameplayAbilitySpec;
 
@@ -22,6 +23,8 @@ class EXTENDEDGAMEPLAYABILITIES_API UVM_GameplayAbility : public UAbilitySystemV
 {
 	GENERATED_BODY()
 
+	friend UAbilitySystemViewModelRouter;
+
 protected:
 	UPROPERTY(BlueprintReadWrite, FieldNotify, Setter)
 	FGameplayAbilitySpecHandle AbilitySpecHandle;
@@ -30,6 +33,8 @@ public:
 	UFUNCTION(BlueprintSetter)
 	virtual void SetAbilitySpecHandle(FGameplayAbilitySpecHandle NewAbilitySpecHandle);
 
+	FGameplayAbilitySpecHandle GetAbilitySpecHandle() const { return AbilitySpecHandle; }
+
 	UFUNCTION(BlueprintCallable)
 	virtual void SetAbilitySystemAndSpecHandle(UAbilitySystemComponent* NewAbilitySystem, FGameplayAbilitySpecHandle NewAbilitySpecHandle);
 
@@ -40,15 +45,33 @@ public:
 	UFUNCTION(BlueprintPure, FieldNotify)
 	bool IsActive() const;
 
-	/** Can the ability be activated? */
+	/**
+	 * Can the ability be activated?
+	 * The result is cached until a cost attribute, cooldown tag, activation tag, or ability block changes.
+	 */
 	UFUNCTION(BlueprintPure, FieldNotify)
 	bool CanActivate() const;
 
+	/**
+	 * Re-evaluate CanActivate the next time it's read, and broadcast the change.
+	 * Use this when activation depends on state that isn't tracked, e.g. custom CanActivateAbility logic.
+	 */
+	UFUNCTION(BlueprintCallable)
+	void InvalidateCanActivate();
+
+	/**
+	 * Get the tags whose presence on the ability system can affect activation, from the ability's
+	 * activation required and blocked tags, and any tag relationship mapping. Cooldown tags are tracked separately.
+	 * @return False if the ability doesn't inherit UExtendedGameplayAbility, and any tag may affect activation.
+	 */
+	bool GetActivationRelevantTags(FGameplayTagContainer& OutTags) const;
+
 	UFUNCTION(BlueprintPure, FieldNotify)
 	bool IsOnCooldown() const;
 
+	/** Return the ability's cooldown tags, which are cached when the ability changes. */
 	UFUNCTION(BlueprintPure, FieldNotify)
-	FGameplayTagContainer GetCooldownTags() const;
+	FGameplayTagContainer GetCooldownTags() const { return CooldownTags; }
 
 	/** Return all gameplay attributes that are used in the abilities Cost effect. */
 	UFUNCTION(BlueprintPure, FieldNotify)
@@ -57,6 +80,7 @@ public:
 	/**
 	 * Get the currently active cooldown gameplay effect for this ability, if any.
 	 * If multiple are active, return the one that will end last.
+	 * The effect is tracked as cooldown effects are added and removed, so this is cheap to poll.
 	 */
 	UFUNCTION(BlueprintPure, FieldNotify)
 	FActiveGameplayEffectHandle GetActiveCooldownEffect() const;
@@ -80,11 +104,18 @@ public:
 	FCooldownEffectAppliedDynDelegate OnCooldownEffectAppliedEvent;
 
 protected:
-	/** Cooldown tags that were registered for change events. */
-	FGameplayTagContainer RegisteredCooldownTags;
+	/** The shared router that dispatches ability system events to this view model. */
+	UPROPERTY(Transient)
+	TObjectPtr<UAbilitySystemViewModelRouter> Router;
+
+	/** The cached cooldown tags of the ability. */
+	FGameplayTagContainer CooldownTags;
+
+	/** The active cooldown effect that will end last, if any. */
+	FActiveGameplayEffectHandle ActiveCooldownEffect;
 
-	/** Cost attributes that were registered for change events. */
-	TArray<FGameplayAttribute> RegisteredCostAttributes;
+	/** The end time of the active cooldown effect, updated when its start time or duration changes. */
+	float ActiveCooldownEffectEndTime = 0.f;
 
 	/**
 	 * True during OnAnyAbilityActivated, and used by IsActive to temporarily return true,
@@ -92,14 +123,33 @@ protected:
 	 */
 	bool bIsActivating = false;
 
+	/** Whether the cached CanActivate result needs to be re-evaluated. */
+	mutable bool bIsCanActivateDirty = true;
+
+	/** The last evaluated CanActivate result. */
+	mutable bool bCachedCanActivate = false;
+
+	/** Evaluate whether the ability can be activated, ignoring the cache. */
+	virtual bool EvaluateCanActivate() const;
+
+	/** Find the active cooldown effect that will end last by searching all active effects. */
+	FActiveGameplayEffectHandle FindActiveCooldownEffect(float& OutEndTime, FActiveGameplayEffectHandle IgnoreHandle = FActiveGameplayEffectHandle()) const;
+
+	void SetActiveCooldownEffect(FActiveGameplayEffectHandle NewCooldownEffect, float NewEndTime);
+
+	void BindToActiveCooldownEffect();
+	void UnbindFromActiveCooldownEffect();
+
 	virtual void PreSystemChange() override;
 	virtual void PostSystemChange() override;
 	virtual void OnAnyAbilityActivated(UGameplayAbility* GameplayAbility);
 	virtual void OnAnyAbilityEnded(const FAbilityEndedData& AbilityEndedData);
 	virtual void OnCostAttributeChanged(const FOnAttributeChangeData& AttributeChangeData);
 	virtual void OnCooldownTagChanged(FGameplayTag GameplayTag, int32 NewCount);
-	virtual void OnAnyTagChanged(FGameplayTag GameplayTag, int32 NewCount);
+	virtual void OnActivationTagChanged(FGameplayTag GameplayTag, int32 NewCount);
 	virtual void OnActiveGameplayEffectAdded(UAbilitySystemComponent* AbilitySystemComponent,
 	                                         const FGameplayEffectSpec& GameplayEffectSpec,
 	                                         FActiveGameplayEffectHandle ActiveGameplayEffectHandle);
+	virtual void OnActiveCooldownEffectRemoved(const FActiveGameplayEffect& ActiveGameplayEffect);
+	virtual void OnActiveCooldownEffectTimeChanged(FActiveGameplayEffectHandle ActiveGameplayEffectHandle, float NewStartTime, float NewDuration);
 };
@@ -11,6 +11,7 @@
 
 /**
  * A viewmodel for displaying a gameplay attribute for an ability system.
+ * Value notifications can be quantized and rate limited for frequently changing attributes, such as regenerating ones.
  */
 UCLASS(BlueprintType)
 class EXTENDEDGAMEPLAYABILITIES_API UVM_GameplayAttribute : public UAbilitySystemViewModelBase
@@ -22,7 +23,27 @@ protected:
 	UPROPERTY(BlueprintReadWrite, FieldNotify, Setter)
 	FGameplayAttribute Attribute;
 
+	/**
+	 * Only notify value changes that differ from the last notified value by at least this amount.
+	 * Smaller changes are suppressed, and the latest value is notified once after it stops changing for SettleDelay.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float ValueChangeTolerance = 0.f;
+
+	/** The time in seconds without changes after which a value within ValueChangeTolerance is notified. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float SettleDelay = 0.5f;
+
+	/**
+	 * The maximum number of value notifications per second. If 0, notify on every change.
+	 * Changes within the interval are coalesced, and the latest value is notified at the end of it.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float MaxNotifyRate = 0.f;
+
 public:
+	virtual void BeginDestroy() override;
+
 	UFUNCTION(BlueprintSetter)
 	void SetAttribute(FGameplayAttribute NewAttribute);
 
@@ -35,7 +56,32 @@ public:
 	float GetValue() const;
 
 protected:
+	/** The value when GetValue was last notified. */
+	float LastNotifiedValue = 0.f;
+
+	/** The time when GetValue was last notified. */
+	double LastNotifyTime = 0.0;
+
+	/** The time of the last change that was suppressed for being within ValueChangeTolerance. */
+	double LastSuppressedChangeTime = 0.0;
+
+	/** The time at which the pending value notification will run. */
+	double PendingNotifyTime = 0.0;
+
+	/** Ticker for a pending value notification, when rate limited or waiting for the value to settle. */
+	FTSTicker::FDelegateHandle PendingNotifyTickerHandle;
+
 	virtual void PreSystemChange() override;
 	virtual void PostSystemChange() override;
 	virtual void OnAttributeValueChanged(const FOnAttributeChangeData& ChangeData);
+
+	/** Notify a value change if it exceeds the tolerance, or schedule it if it's too soon since the last notify. */
+	void UpdateValueNotify();
+
+	/** Schedule a notification of the latest value, unless one is already pending at or before that time. */
+	void SchedulePendingNotify(double Delay);
+
+	void NotifyValueChanged(float NewValue);
+	void ClearPendingNotify();
+	bool HandlePendingNotifyTicker(float DeltaTime);
 };
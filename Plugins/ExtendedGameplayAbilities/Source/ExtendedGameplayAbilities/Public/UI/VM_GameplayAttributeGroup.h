@@ -0,0 +1,105 @@
+﻿// Copyright Bohdon Sayre, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemViewModelBase.h"
+#include "AttributeSet.h"
+#include "GameplayEffectTypes.h"
+#include "VM_GameplayAttributeGroup.generated.h"
+
+
+/**
+ * A viewmodel for displaying several gameplay attributes of an ability system, such as the attributes of a unit frame.
+ * All attributes share one view model and one change handler, and changes are exposed both as a
+ * single GetValues field notification and as a per-attribute event.
+ * Notifications are quantized and rate limited the same way as UVM_GameplayAttribute.
+ */
+UCLASS(BlueprintType)
+class EXTENDEDGAMEPLAYABILITIES_API UVM_GameplayAttributeGroup : public UAbilitySystemViewModelBase
+{
+	GENERATED_BODY()
+
+protected:
+	/** The gameplay attributes. */
+	UPROPERTY(BlueprintReadWrite, FieldNotify, Setter)
+	TArray<FGameplayAttribute> Attributes;
+
+	/**
+	 * Only notify when an attribute differs from its last notified value by at least this amount.
+	 * Smaller changes are suppressed, and notified once after the attributes stop changing for SettleDelay.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float ValueChangeTolerance = 0.f;
+
+	/** The time in seconds without changes after which values within ValueChangeTolerance are notified. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float SettleDelay = 0.5f;
+
+	/**
+	 * The maximum number of value notifications per second. If 0, notify on every change.
+	 * Changes within the interval are coalesced, and the latest values are notified at the end of it.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float MaxNotifyRate = 0.f;
+
+public:
+	virtual void BeginDestroy() override;
+
+	UFUNCTION(BlueprintSetter)
+	void SetAttributes(const TArray<FGameplayAttribute>& NewAttributes);
+
+	UFUNCTION(BlueprintCallable)
+	void SetAbilitySystemAndAttributes(UAbilitySystemComponent* NewAbilitySystem, const TArray<FGameplayAttribute>& NewAttributes);
+
+	const TArray<FGameplayAttribute>& GetAttributes() const { return Attributes; }
+
+	/** Return the current value of an attribute. */
+	UFUNCTION(BlueprintPure)
+	float GetAttributeValue(FGameplayAttribute InAttribute) const;
+
+	/** Return the current values of all attributes, in the same order as Attributes. */
+	UFUNCTION(BlueprintPure, FieldNotify)
+	TArray<float> GetValues() const;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FAttributeValueChangedDynDelegate, FGameplayAttribute, Attribute, float, NewValue, float, OldValue);
+
+	/** Called for each attribute that changed when the group values are notified. OldValue is the last notified value. */
+	UPROPERTY(BlueprintAssignable)
+	FAttributeValueChangedDynDelegate OnAttributeValueChangedEvent;
+
+protected:
+	/** Attributes that were bound for change events. */
+	TArray<FGameplayAttribute> BoundAttributes;
+
+	/** The value of each attribute when GetValues was last notified, in the same order as Attributes. */
+	TArray<float> LastNotifiedValues;
+
+	/** The time when GetValues was last notified. */
+	double LastNotifyTime = 0.0;
+
+	/** The time of the last change that was suppressed for being within ValueChangeTolerance. */
+	double LastSuppressedChangeTime = 0.0;
+
+	/** The time at which the pending notification will run. */
+	double PendingNotifyTime = 0.0;
+
+	/** Ticker for a pending notification, when rate limited or waiting for values to settle. */
+	FTSTicker::FDelegateHandle PendingNotifyTickerHandle;
+
+	virtual void PreSystemChange() override;
+	virtual void PostSystemChange() override;
+	virtual void OnAttributeValueChanged(const FOnAttributeChangeData& ChangeData);
+
+	/**
+	 * Notify all changed attributes if any of them exceeds the tolerance, or if bSettled is true.
+	 * Otherwise schedule a notification for when the values have settled.
+	 */
+	void NotifyValuesChanged(bool bSettled);
+
+	/** Schedule a notification of the latest values, unless one is already pending at or before that time. */
+	void SchedulePendingNotify(double Delay);
+
+	void ClearPendingNotify();
+	bool HandlePendingNotifyTicker(float DeltaTime);
+};
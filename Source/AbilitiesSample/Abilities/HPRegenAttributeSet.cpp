@@ -21,5 +21,5 @@ void UHPRegenAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION_NOTIFY(UHPRegenAttributeSet, HPRegen, COND_None, REPNOTIFY_Always);
+	EXTENDED_ATTRIBUTE_REPLIFETIME(UHPRegenAttributeSet, HPRegen);
 }
@@ -14,6 +14,12 @@ UStaminaAttributeSet::UStaminaAttributeSet()
 
 	SetMaxAttribute(GetStaminaAttribute(), GetMaxStaminaAttribute(), false);
 	SetAttributeValueRange(GetMaxStaminaAttribute(), 1, FLT_MAX);
+
+	// stamina changes constantly while regenerating, so replicate it compactly at reduced precision
+	SetUseCompactReplication(true);
+	SetAttributeQuantization(GetStaminaAttribute(), 0.1f);
+	SetAttributeQuantization(GetMaxStaminaAttribute(), 1.f);
+	SetAttributeQuantization(GetStaminaRegenAttribute(), 0.1f);
 }
 
 void UStaminaAttributeSet::OnRep_Stamina(FGameplayAttributeData& OldValue)
@@ -35,7 +41,7 @@ void UStaminaAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION_NOTIFY(UStaminaAttributeSet, Stamina, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UStaminaAttributeSet, MaxStamina, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UStaminaAttributeSet, StaminaRegen, COND_None, REPNOTIFY_Always);
+	EXTENDED_ATTRIBUTE_REPLIFETIME(UStaminaAttributeSet, Stamina);
+	EXTENDED_ATTRIBUTE_REPLIFETIME(UStaminaAttributeSet, MaxStamina);
+	EXTENDED_ATTRIBUTE_REPLIFETIME(UStaminaAttributeSet, StaminaRegen);
 }